@@ -0,0 +1,942 @@
+/*
+Author: Samuel R. Blackburn
+Internet: wfc@pobox.com
+
+"You can get credit for something or get it done, but not both."
+Dr. Richard Garwin
+
+The MIT License (MIT)
+
+Copyright (c) 1996-2019 Sam Blackburn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../nmea0183.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <stdlib.h>
+
+/*
+** Times parsing, field access and writing for each kind of sentence and
+** prints the results as JSON laid out like Google Benchmark's, so two runs
+** can be compared with its tools/compare.py or anything else that reads
+** JSON. Give a name fragment to run just the matching benchmarks:
+**
+**    ./bench > before.json
+**    ./bench Parse/ > parse_only.json
+**
+** Heap allocations are counted by replacing the global operator new. The
+** ingest benchmarks allocate on several threads, so the count is atomic.
+*/
+
+static std::atomic<std::size_t> number_of_allocations{ 0 };
+
+void * operator new( std::size_t size )
+{
+   number_of_allocations.fetch_add( 1, std::memory_order_relaxed );
+
+   auto const pointer{ ::malloc( size == 0 ? 1 : size ) };
+
+   if ( pointer == nullptr )
+   {
+      throw std::bad_alloc();
+   }
+
+   return( pointer );
+}
+
+/*
+** GCC can't see that these pair up with the operator new above once it
+** inlines them into a vector, and warns about free() of a new'd pointer
+*/
+
+#if defined( __GNUC__ ) and ! defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete( void * pointer ) noexcept
+{
+   ::free( pointer );
+}
+
+void operator delete( void * pointer, std::size_t ) noexcept
+{
+   ::free( pointer );
+}
+
+#if defined( __GNUC__ ) and ! defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+struct CORPUS_ENTRY
+{
+   std::string_view name;
+   std::string_view sentence;
+   int              weight{ 1 }; // How many times it shows up in 100 lines of a typical log
+};
+
+static CORPUS_ENTRY const corpus[]
+{
+   { STRING_VIEW("RMC"),         STRING_VIEW("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"), 20 },
+   { STRING_VIEW("GGA"),         STRING_VIEW("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"), 20 },
+   { STRING_VIEW("GSV"),         STRING_VIEW("$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"), 6 },
+   { STRING_VIEW("GSV"),         STRING_VIEW("$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74\r\n"), 6 },
+   { STRING_VIEW("GSV"),         STRING_VIEW("$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D\r\n"), 6 },
+   { STRING_VIEW("VTG"),         STRING_VIEW("$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n"), 15 },
+   { STRING_VIEW("HDT"),         STRING_VIEW("$HEHDT,274.07,T*19\r\n"), 15 },
+   { STRING_VIEW("XDR"),         STRING_VIEW("$IIXDR,C,19.52,C,TempAir,P,1.02481,B,Barometer*7E\r\n"), 5 },
+   { STRING_VIEW("RTE"),         STRING_VIEW("$GPRTE,2,1,c,0,PBRCPK,PBRTO,PTELGR,PPLAND,PYAMBU,PPFAIR,PWARRN,PMORTL,PLISMR*73\r\n"), 1 },
+   { STRING_VIEW("P"),           STRING_VIEW("$PGRME,15.0,M,45.0,M,25.0,M*1C\r\n"), 3 },
+   { STRING_VIEW("BadChecksum"), STRING_VIEW("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6B\r\n"), 2 },
+   { STRING_VIEW("Unknown"),     STRING_VIEW("$GPXYZ,1,2,3*50\r\n"), 1 },
+};
+
+struct RESULT
+{
+   std::size_t number_of_items{ 0 };
+   double      nanoseconds{ 0.0 };
+   std::size_t number_of_allocations{ 0 };
+};
+
+template <typename FUNCTION>
+static RESULT measure( std::size_t items_per_call, FUNCTION function )
+{
+   // One call to warm things up, the first one is allowed to allocate
+
+   function();
+
+   RESULT result;
+
+   auto const allocations_at_start{ number_of_allocations.load( std::memory_order_relaxed ) };
+   auto const start{ std::chrono::steady_clock::now() };
+   auto finish{ start };
+
+   do
+   {
+      for ( int loop_index{ 0 }; loop_index < 100; loop_index++ )
+      {
+         function();
+      }
+
+      result.number_of_items += 100 * items_per_call;
+      finish = std::chrono::steady_clock::now();
+   }
+   while( finish - start < std::chrono::milliseconds( 200 ) );
+
+   result.nanoseconds = std::chrono::duration<double, std::nano>( finish - start ).count();
+   result.number_of_allocations = number_of_allocations.load( std::memory_order_relaxed ) - allocations_at_start;
+
+   return( result );
+}
+
+static char const * filter{ nullptr };
+static bool first_benchmark{ true };
+
+static bool wanted( std::string const& name ) noexcept
+{
+   return( filter == nullptr or name.find( filter ) not_eq name.npos );
+}
+
+static void report( std::string const& name, RESULT const& result )
+{
+   auto const items{ static_cast<double>( result.number_of_items ) };
+   auto const nanoseconds_per_item{ result.nanoseconds / items };
+
+   printf( "%s    {\n", first_benchmark ? "" : ",\n" );
+   printf( "      \"name\": \"%s\",\n", name.c_str() );
+   printf( "      \"run_name\": \"%s\",\n", name.c_str() );
+   printf( "      \"run_type\": \"iteration\",\n" );
+   printf( "      \"iterations\": %zu,\n", result.number_of_items );
+   printf( "      \"real_time\": %.3f,\n", nanoseconds_per_item );
+   printf( "      \"cpu_time\": %.3f,\n", nanoseconds_per_item );
+   printf( "      \"time_unit\": \"ns\",\n" );
+   printf( "      \"items_per_second\": %.1f,\n", 1.0e9 / nanoseconds_per_item );
+   printf( "      \"allocations_per_item\": %.3f\n", static_cast<double>( result.number_of_allocations ) / items );
+   printf( "    }" );
+
+   first_benchmark = false;
+}
+
+template <typename FUNCTION>
+static void run( std::string const& name, std::size_t items_per_call, FUNCTION function )
+{
+   if ( wanted( name ) == true )
+   {
+      report( name, measure( items_per_call, function ) );
+   }
+}
+
+static void parse_benchmarks( void )
+{
+   NMEA0183 nmea0183;
+   volatile bool sink{ false };
+
+   for ( auto const& entry : corpus )
+   {
+      // GSV has three lines in the corpus, time the first
+
+      if ( &entry not_eq &corpus[ 0 ] and ( &entry - 1 )->name == entry.name )
+      {
+         continue;
+      }
+
+      run( "Parse/" + std::string( entry.name ), 1, [&]()
+      {
+         nmea0183 << entry.sentence;
+         sink = nmea0183.Parse();
+      } );
+   }
+
+   nmea0183.FillTextOnParse = false;
+
+   run( "Parse/RMC/NoText", 1, [&]()
+   {
+      nmea0183 << corpus[ 0 ].sentence;
+      sink = nmea0183.Parse();
+   } );
+
+   // Straight out of the receive buffer, no copy of the line or its strings
+
+   nmea0183.Rmc.CopyStrings = false;
+
+   run( "Parse/RMC/Borrowed", 1, [&]()
+   {
+      nmea0183.BorrowSentence( corpus[ 0 ].sentence );
+      sink = nmea0183.Parse();
+   } );
+
+   nmea0183.Rmc.CopyStrings = true;
+   nmea0183.FillTextOnParse = true;
+
+   /*
+   ** A log's worth of lines in the proportions real traffic has
+   */
+
+   std::vector<std::string_view> log;
+
+   for ( auto const& entry : corpus )
+   {
+      for ( int loop_index{ 0 }; loop_index < entry.weight; loop_index++ )
+      {
+         log.push_back( entry.sentence );
+      }
+   }
+
+   // Spread them out so the branch predictor can't learn the order
+
+   for ( std::size_t index{ 0 }; index < log.size(); index++ )
+   {
+      std::swap( log[ index ], log[ ( index * 37 ) % log.size() ] );
+   }
+
+   run( "Parse/Mixed", log.size(), [&]()
+   {
+      for ( auto const sentence : log )
+      {
+         nmea0183 << sentence;
+         sink = nmea0183.Parse();
+      }
+   } );
+
+   // A display that only wants heading and GPS fixes
+
+   NMEA0183 subscribed;
+   volatile double heading_sink{ 0.0 };
+
+   subscribed.FillTextOnParse = false;
+   std::ignore = subscribed.Subscribe<HDT>( [&]( HDT const& hdt ) { heading_sink = hdt.DegreesTrue; } );
+   std::ignore = subscribed.Subscribe<RMC>( [&]( RMC const& rmc ) { heading_sink = rmc.TrackMadeGoodDegreesTrue; }, { "GP", "GN" } );
+
+   run( "Parse/Mixed/Subscribed<HDT,RMC>", log.size(), [&]()
+   {
+      for ( auto const sentence : log )
+      {
+         subscribed << sentence;
+         sink = subscribed.Parse();
+      }
+   } );
+
+   std::ignore = heading_sink;
+
+   /*
+   ** Instruments heard three times over, through two bridges, changing
+   ** every other round
+   */
+
+   static constexpr std::string_view readings[]
+   {
+      STRING_VIEW( "$IIMTW,18.5,C*1F\r\n" ), STRING_VIEW( "$SDDPT,12.3,0.5*62\r\n" ), STRING_VIEW( "$IIXDR,C,19.5,C,AIRTEMP*0B\r\n" ), STRING_VIEW( "$HCHDG,274.1,,,5.2,W*3C\r\n" ),
+      STRING_VIEW( "$IIMTW,18.6,C*1C\r\n" ), STRING_VIEW( "$SDDPT,12.4,0.5*65\r\n" ), STRING_VIEW( "$IIXDR,C,19.6,C,AIRTEMP*08\r\n" ), STRING_VIEW( "$HCHDG,274.3,,,5.2,W*3E\r\n" ),
+   };
+
+   std::vector<std::string_view> repeats;
+
+   for ( std::size_t round{ 0 }; round < 8; round++ )
+   {
+      for ( std::size_t reading{ 0 }; reading < 4; reading++ )
+      {
+         repeats.insert( repeats.end(), 3, readings[ ( ( round % 2 ) * 4 ) + reading ] );
+      }
+   }
+
+   NMEA0183 repeated;
+   DUPLICATE_FILTER duplicates;
+
+   repeated.FillTextOnParse = false;
+
+   run( "Parse/Repeats", repeats.size(), [&]()
+   {
+      for ( auto const sentence : repeats )
+      {
+         repeated << sentence;
+         sink = repeated.Parse();
+      }
+   } );
+
+   repeated.Duplicates = &duplicates;
+
+   run( "Parse/Repeats/Duplicates", repeats.size(), [&]()
+   {
+      for ( auto const sentence : repeats )
+      {
+         repeated << sentence;
+         sink = repeated.Parse();
+      }
+   } );
+
+   NMEA0183_PARSER<RMC, GGA, VTG, HDT> parser;
+
+   run( "Parser<RMC,GGA,VTG,HDT>/Mixed", log.size(), [&]()
+   {
+      for ( auto const sentence : log )
+      {
+         parser << sentence;
+         sink = parser.Parse();
+      }
+   } );
+
+   std::ignore = sink;
+}
+
+static void sentence_benchmarks( void )
+{
+   SENTENCE sentence;
+   volatile double double_sink{ 0.0 };
+   volatile int integer_sink{ 0 };
+   volatile time_t time_sink{ 0 };
+
+   auto const rmc{ corpus[ 0 ].sentence };
+
+   run( "SENTENCE/Assign+ComputeChecksum", 1, [&]()
+   {
+      sentence = rmc;
+      integer_sink = sentence.ComputeChecksum();
+   } );
+
+   sentence = rmc;
+
+   run( "SENTENCE/IsChecksumBad", 1, [&]() { integer_sink = static_cast<int>( sentence.IsChecksumBad( 12 ) ); } );
+   run( "SENTENCE/Field", 1, [&]() { integer_sink = static_cast<int>( sentence.Field( 3 ).length() ); } );
+   run( "SENTENCE/Double", 1, [&]() { double_sink = sentence.Double( 7 ); } );
+   run( "SENTENCE/Integer", 1, [&]() { integer_sink = sentence.Integer( 9 ); } );
+   run( "SENTENCE/Time", 1, [&]() { time_sink = sentence.Time( 1 ); } );
+   run( "SENTENCE/NorthOrSouth", 1, [&]() { integer_sink = static_cast<int>( sentence.NorthOrSouth( 4 ) ); } );
+   run( "Lookup/Manufacturer", 1, [&]() { integer_sink = static_cast<int>( MANUFACTURER_LIST::Find( STRING_VIEW( "GRM" ) ).length() ); } );
+   run( "Lookup/TalkerID", 1, [&]() { integer_sink = static_cast<int>( talker_description( STRING_VIEW( "GP" ) ).length() ); } );
+
+   std::ignore = double_sink;
+   std::ignore = integer_sink;
+   std::ignore = time_sink;
+}
+
+static void coordinate_benchmarks( void )
+{
+   SENTENCE sentence;
+   LATITUDE latitude;
+   volatile double double_sink{ 0.0 };
+   volatile int integer_sink{ 0 };
+
+   sentence = corpus[ 0 ].sentence;
+
+   run( "LATITUDE/Parse", 1, [&]() { latitude.Parse( 3, 4, sentence ); } );
+
+   latitude.Parse( 3, 4, sentence );
+
+   run( "LATITUDE/GetDecimalDegrees", 1, [&]() { double_sink = latitude.GetDecimalDegrees(); } );
+   run( "LATITUDE/GetWholeDegrees", 1, [&]() { integer_sink = latitude.GetWholeDegrees(); } );
+
+   // A track's worth of latitude and longitude fields
+
+   std::vector<std::string> text;
+
+   for ( int index{ 0 }; index < 1024; index++ )
+   {
+      char field[ 32 ];
+
+      text.emplace_back( field, ::sprintf( field, "%05.4f", 1000.0 + index * 3.7137 ) );
+      text.emplace_back( field, ::sprintf( field, "%05.4f", 12000.0 + index * 1.1171 ) );
+   }
+
+   std::vector<std::string_view> angles( text.begin(), text.end() );
+   std::vector<std::string_view> hemispheres( angles.size(), "S" );
+   std::vector<double> degrees( angles.size() );
+   std::vector<int32_t> microdegrees( angles.size() );
+
+   run( "angles_to_degrees", angles.size(), [&]()
+   {
+      integer_sink = static_cast<int>( angles_to_degrees( angles.data(), hemispheres.data(), angles.size(), degrees.data() ) );
+   } );
+
+   run( "angles_to_microdegrees", angles.size(), [&]()
+   {
+      integer_sink = static_cast<int>( angles_to_microdegrees( angles.data(), hemispheres.data(), angles.size(), microdegrees.data() ) );
+   } );
+
+   std::ignore = double_sink;
+   std::ignore = integer_sink;
+}
+
+static void write_benchmarks( void )
+{
+   NMEA0183 nmea0183;
+
+   for ( auto const& entry : corpus )
+   {
+      nmea0183 << entry.sentence;
+      nmea0183.Parse();
+   }
+
+   std::pair<std::string_view, RESPONSE const *> const responses[]
+   {
+      { STRING_VIEW("RMC"), &nmea0183.Rmc },
+      { STRING_VIEW("GGA"), &nmea0183.Gga },
+      { STRING_VIEW("GSV"), &nmea0183.Gsv },
+      { STRING_VIEW("VTG"), &nmea0183.Vtg },
+      { STRING_VIEW("HDT"), &nmea0183.Hdt },
+      { STRING_VIEW("XDR"), &nmea0183.Xdr },
+      { STRING_VIEW("RTE"), &nmea0183.Rte },
+   };
+
+   for ( auto const& response : responses )
+   {
+      SENTENCE sentence;
+
+      run( "Write/" + std::string( response.first ), 1, [&]() { response.second->Write( sentence ); } );
+
+      char buffer[ 128 ];
+      SENTENCE_ENCODER encoder( buffer );
+
+      run( "Encode/" + std::string( response.first ), 1, [&]() { encoder.Encode( *response.second ); } );
+   }
+}
+
+/*
+** A synthetic AIS corpus, mostly Class A position reports with the odd
+** static and voyage report (two fragments) and Class B traffic mixed in
+*/
+
+class PAYLOAD_WRITER
+{
+   private:
+
+      std::vector<bool> m_Bits;
+
+   public:
+
+      void Put( uint32_t const value, int const number_of_bits )
+      {
+         for ( int bit_number{ number_of_bits - 1 }; bit_number >= 0; bit_number-- )
+         {
+            m_Bits.push_back( ( ( value >> bit_number ) bitand 1 ) == 1 );
+         }
+      }
+
+      void PutText( std::string_view text, std::size_t const number_of_characters )
+      {
+         for ( std::size_t index{ 0 }; index < number_of_characters; index++ )
+         {
+            auto const character{ index < text.length() ? text[ index ] : '@' };
+
+            Put( static_cast<uint32_t>( character bitand 0x3F ), 6 );
+         }
+      }
+
+      // Returns the six bit characters and how many fill bits were needed
+
+      std::pair<std::string, int> Armor( void ) const
+      {
+         std::string characters;
+
+         auto const number_of_fill_bits{ static_cast<int>( ( 6 - m_Bits.size() % 6 ) % 6 ) };
+
+         for ( std::size_t index{ 0 }; index < m_Bits.size(); index += 6 )
+         {
+            uint32_t value{ 0 };
+
+            for ( std::size_t bit_index{ index }; bit_index < index + 6; bit_index++ )
+            {
+               value = ( value << 1 ) bitor ( bit_index < m_Bits.size() and m_Bits[ bit_index ] ? 1 : 0 );
+            }
+
+            characters.push_back( static_cast<char>( value < 40 ? value + 48 : value + 56 ) );
+         }
+
+         return( std::make_pair( characters, number_of_fill_bits ) );
+      }
+};
+
+static std::string ais_sentence( int const number_of_fragments, int const fragment_number, int const sequence, char const channel, std::string_view payload, int const number_of_fill_bits )
+{
+   std::string sentence( STRING_VIEW("!AIVDM,") );
+
+   sentence.append( std::to_string( number_of_fragments ) );
+   sentence.push_back( ',' );
+   sentence.append( std::to_string( fragment_number ) );
+   sentence.push_back( ',' );
+
+   if ( number_of_fragments > 1 )
+   {
+      sentence.append( std::to_string( sequence ) );
+   }
+
+   sentence.push_back( ',' );
+   sentence.push_back( channel );
+   sentence.push_back( ',' );
+   sentence.append( payload );
+   sentence.push_back( ',' );
+   sentence.append( std::to_string( number_of_fill_bits ) );
+
+   auto const checksum{ xor_characters( sentence.data() + 1, sentence.length() - 1 ) };
+
+   sentence.push_back( '*' );
+   sentence.push_back( hex_digit( checksum >> 4 ) );
+   sentence.push_back( hex_digit( checksum ) );
+   sentence.append( STRING_VIEW("\r\n") );
+
+   return( sentence );
+}
+
+static std::vector<std::string> ais_corpus( std::size_t const number_of_messages )
+{
+   std::vector<std::string> corpus;
+
+   uint32_t random{ 12345 };
+
+   auto const next_random{ [&random]( uint32_t const maximum )
+   {
+      random = random * 1103515245 + 12345;
+      return( ( random >> 8 ) % maximum );
+   } };
+
+   for ( std::size_t message_number{ 0 }; message_number < number_of_messages; message_number++ )
+   {
+      PAYLOAD_WRITER writer;
+
+      auto const kind{ message_number % 20 };
+      auto const mmsi{ 200000000 + next_random( 500000000 ) };
+      auto const channel{ ( message_number % 2 ) == 0 ? 'A' : 'B' };
+
+      if ( kind == 0 )
+      {
+         writer.Put( 5, 6 ); writer.Put( 0, 2 ); writer.Put( mmsi, 30 );
+         writer.Put( 0, 2 ); writer.Put( next_random( 10000000 ), 30 );
+         writer.PutText( STRING_VIEW("CALL123"), 7 ); writer.PutText( STRING_VIEW("SYNTHETIC VESSEL"), 20 );
+         writer.Put( 70, 8 ); writer.Put( 150, 9 ); writer.Put( 30, 9 ); writer.Put( 10, 6 ); writer.Put( 12, 6 );
+         writer.Put( 1, 4 ); writer.Put( 5, 4 ); writer.Put( 15, 5 ); writer.Put( 14, 5 ); writer.Put( 30, 6 );
+         writer.Put( 122, 8 ); writer.PutText( STRING_VIEW("ROTTERDAM"), 20 ); writer.Put( 0, 1 ); writer.Put( 0, 1 );
+
+         auto const [ payload, number_of_fill_bits ] { writer.Armor() };
+         auto const sequence{ static_cast<int>( message_number / 20 ) % 10 };
+
+         corpus.push_back( ais_sentence( 2, 1, sequence, channel, std::string_view( payload ).substr( 0, 60 ), 0 ) );
+         corpus.push_back( ais_sentence( 2, 2, sequence, channel, std::string_view( payload ).substr( 60 ), number_of_fill_bits ) );
+         continue;
+      }
+
+      if ( kind == 1 or kind == 2 )
+      {
+         writer.Put( 18, 6 ); writer.Put( 0, 2 ); writer.Put( mmsi, 30 ); writer.Put( 0, 8 );
+         writer.Put( next_random( 300 ), 10 ); writer.Put( 1, 1 );
+         writer.Put( next_random( 216000000 ), 28 ); writer.Put( next_random( 108000000 ), 27 );
+         writer.Put( next_random( 3600 ), 12 ); writer.Put( 511, 9 ); writer.Put( next_random( 60 ), 6 );
+         writer.Put( 0, 2 ); writer.Put( 0x7F, 7 ); writer.Put( next_random( 1 << 20 ), 20 );
+      }
+      else if ( kind == 3 )
+      {
+         writer.Put( 24, 6 ); writer.Put( 0, 2 ); writer.Put( mmsi, 30 ); writer.Put( 0, 2 );
+         writer.PutText( STRING_VIEW("SYNTHETIC YACHT"), 20 );
+      }
+      else
+      {
+         writer.Put( 1 + static_cast<uint32_t>( kind % 3 ), 6 ); writer.Put( 0, 2 ); writer.Put( mmsi, 30 );
+         writer.Put( 0, 4 ); writer.Put( 0, 8 ); writer.Put( next_random( 300 ), 10 ); writer.Put( 1, 1 );
+         writer.Put( next_random( 216000000 ), 28 ); writer.Put( next_random( 108000000 ), 27 );
+         writer.Put( next_random( 3600 ), 12 ); writer.Put( next_random( 360 ), 9 ); writer.Put( next_random( 60 ), 6 );
+         writer.Put( 0, 2 ); writer.Put( 0, 3 ); writer.Put( 0, 1 ); writer.Put( next_random( 1 << 19 ), 19 );
+      }
+
+      auto const [ payload, number_of_fill_bits ] { writer.Armor() };
+
+      corpus.push_back( ais_sentence( 1, 1, 0, channel, payload, number_of_fill_bits ) );
+   }
+
+   return( corpus );
+}
+
+static void ais_benchmarks( void )
+{
+   auto const corpus{ ais_corpus( 1000 ) };
+
+   NMEA0183_PARSER<VDM> parser;
+   volatile bool sink{ false };
+
+   run( "AIS/Parser<VDM>/Mixed", corpus.size(), [&]()
+   {
+      for ( auto const& sentence : corpus )
+      {
+         parser << sentence;
+         sink = parser.Parse();
+      }
+   } );
+
+   NMEA0183 nmea0183;
+
+   nmea0183.FillTextOnParse = false;
+
+   run( "AIS/Parse/Mixed/NoText", corpus.size(), [&]()
+   {
+      for ( auto const& sentence : corpus )
+      {
+         nmea0183 << sentence;
+         sink = nmea0183.Parse();
+      }
+   } );
+
+   AIS_PAYLOAD payload;
+   AIS_MESSAGE message;
+   auto const armored{ std::string_view( corpus[ 5 ] ).substr( 14, 28 ) };
+
+   run( "AIS/Payload/Unpack+Decode", 1, [&]()
+   {
+      payload.Empty();
+      payload.Append( armored, 0 );
+      sink = message.Decode( payload );
+   } );
+
+   std::ignore = sink;
+}
+
+static void record_benchmarks( void )
+{
+   if ( wanted( "RECORD/" ) == false )
+   {
+      return;
+   }
+
+   // Getting a thousand RMCs back out of a log by parsing the text again
+   // versus replaying them from a record file
+
+   std::string log;
+
+   for ( int index{ 0 }; index < 1000; index++ )
+   {
+      for ( auto const& entry : corpus )
+      {
+         if ( entry.name == "RMC" or entry.name == "GGA" or entry.name == "VTG" or entry.name == "HDT" )
+         {
+            log.append( entry.sentence );
+         }
+      }
+   }
+
+   std::string const filename{ "bench_records.bin" };
+
+   RECORD_WRITER writer;
+
+   if ( writer.Open( filename ) == false or writer.AddLog( log ) == 0 or writer.Close() == false )
+   {
+      return;
+   }
+
+   RECORD_READER reader;
+
+   if ( reader.Open( filename ) == true )
+   {
+      NMEA0183_PARSER<RMC, GGA, VTG, HDT> parser;
+      volatile double sink{ 0.0 };
+
+      parser.FillTextOnParse = false;
+
+      run( "RECORD/ParseText", 1000, [&]()
+      {
+         auto remaining{ std::string_view( log ) };
+
+         while( remaining.empty() == false )
+         {
+            auto const line_length{ remaining.find( LINE_FEED ) + 1 };
+
+            parser << remaining.substr( 0, line_length );
+            remaining.remove_prefix( line_length );
+
+            if ( parser.Parse() == true and parser.LastSentenceIDParsed == "RMC" )
+            {
+               sink = parser.Get<RMC>().SpeedOverGroundKnots;
+            }
+         }
+      } );
+
+      run( "RECORD/Replay<RMC>", 1000, [&]()
+      {
+         std::ignore = reader.Replay<RMC>( INT64_MIN, INT64_MAX, [&]( RMC const& rmc ) { sink = rmc.SpeedOverGroundKnots; } );
+      } );
+
+      std::ignore = sink;
+   }
+
+   reader.Close();
+   std::remove( filename.c_str() );
+}
+
+static void ingest_benchmarks( void )
+{
+   if ( wanted( "Ingest/" ) == false )
+   {
+      return;
+   }
+
+   // Eight feeds of RMC, GGA, VTG and HDT a thousand sentences each
+
+   std::string feed;
+
+   for ( int index{ 0 }; index < 250; index++ )
+   {
+      for ( auto const& entry : corpus )
+      {
+         if ( entry.name == "RMC" or entry.name == "GGA" or entry.name == "VTG" or entry.name == "HDT" )
+         {
+            feed.append( entry.sentence );
+         }
+      }
+   }
+
+   std::size_t const number_of_feeds{ 8 };
+   auto const number_of_sentences{ static_cast<std::size_t>( std::count( feed.begin(), feed.end(), LINE_FEED ) ) * number_of_feeds };
+   volatile double sink{ 0.0 };
+
+   // What we had, a thread and a parser per feed taking turns with a mutex
+
+   run( "Ingest/8 Feeds/Mutex", number_of_sentences, [&]()
+   {
+      std::mutex mutex;
+      std::vector<std::thread> threads;
+
+      for ( std::size_t feed_index{ 0 }; feed_index < number_of_feeds; feed_index++ )
+      {
+         threads.emplace_back( [&]()
+         {
+            NMEA0183_PARSER<RMC, GGA, VTG, HDT> parser;
+            SENTENCE_FRAMER framer;
+            std::string_view sentence;
+
+            parser.FillTextOnParse = false;
+
+            for ( std::size_t offset{ 0 }; offset < feed.length(); offset += 512 )
+            {
+               framer.Write( std::string_view( feed ).substr( offset, 512 ) );
+
+               while( framer.Next( sentence ) == true )
+               {
+                  std::lock_guard<std::mutex> lock( mutex );
+
+                  parser << sentence;
+
+                  if ( parser.Parse() == true and parser.LastSentenceIDParsed == "HDT" )
+                  {
+                     sink = parser.Get<HDT>().DegreesTrue;
+                  }
+               }
+            }
+         } );
+      }
+
+      for ( auto& thread : threads )
+      {
+         thread.join();
+      }
+   } );
+
+   for ( unsigned int number_of_workers : { 1U, 4U } )
+   {
+      run( "Ingest/8 Feeds/Workers:" + std::to_string( number_of_workers ), number_of_sentences, [&]()
+      {
+         using INGEST = NMEA0183_INGEST<RMC, GGA, VTG, HDT>;
+
+         INGEST ingest;
+         std::vector<std::size_t> offsets( number_of_feeds, 0 );
+
+         ingest.NumberOfWorkers = number_of_workers;
+
+         for ( std::size_t feed_index{ 0 }; feed_index < number_of_feeds; feed_index++ )
+         {
+            std::ignore = ingest.AddSource( "Feed", [ &feed, &offset = offsets[ feed_index ] ]( char * buffer, std::size_t size ) -> std::ptrdiff_t
+            {
+               if ( offset >= feed.length() )
+               {
+                  return( -1 );
+               }
+
+               auto const number_of_bytes{ std::min( { size, std::size_t{ 512 }, feed.length() - offset } ) };
+
+               ::memcpy( buffer, feed.data() + offset, number_of_bytes );
+               offset += number_of_bytes;
+
+               return( static_cast<std::ptrdiff_t>( number_of_bytes ) );
+            } );
+         }
+
+         std::ignore = ingest.Start( [&]( INGEST::RESULT const& result )
+         {
+            if ( auto const hdt{ result.Get<HDT>() }; hdt not_eq nullptr )
+            {
+               sink = hdt->DegreesTrue;
+            }
+         } );
+
+         ingest.Wait();
+      } );
+   }
+
+   std::ignore = sink;
+}
+
+static void vessel_state_benchmarks( void )
+{
+   VESSEL_STATE_TRACKER tracker;
+   HDT hdt;
+   double heading{ 0.0 };
+   volatile double sink{ 0.0 };
+
+   run( "VesselState/Update<HDT>", 1, [&]()
+   {
+      heading += 0.1;
+      hdt.DegreesTrue = heading;
+      std::ignore = tracker.Update( hdt, STRING_VIEW( "HE" ), 1 );
+   } );
+
+   run( "VesselState/Update<HDT>/Unchanged", 1, [&]()
+   {
+      std::ignore = tracker.Update( hdt, STRING_VIEW( "HE" ), 1 );
+   } );
+
+   run( "VesselState/Get", 1, [&]()
+   {
+      sink = tracker.Get().HeadingDegreesTrue.Value;
+   } );
+
+   std::ignore = sink;
+}
+
+static void gnss_epoch_benchmarks( void )
+{
+   // The corpus GSV group and its GSA, parsed once, fed as one epoch per call
+
+   NMEA0183 nmea0183;
+   GSV gsv[ 3 ];
+   GSA gsa;
+   std::size_t gsv_index{ 0 };
+
+   for ( auto const& entry : corpus )
+   {
+      nmea0183 << entry.sentence;
+
+      if ( nmea0183.Parse() == true and entry.name == STRING_VIEW( "GSV" ) and gsv_index < std::size( gsv ) )
+      {
+         gsv[ gsv_index++ ] = nmea0183.Gsv;
+      }
+   }
+
+   gsa = nmea0183.Gsa;
+
+   GNSS_EPOCH_TRACKER tracker;
+   int64_t now{ 1 };
+   volatile int sink{ 0 };
+
+   run( "GnssEpoch/Update<GSV,GSA>", 4, [&]()
+   {
+      std::ignore = tracker.Update( gsa, STRING_VIEW( "GP" ), now++ );
+
+      for ( auto const& message : gsv )
+      {
+         std::ignore = tracker.Update( message, STRING_VIEW( "GP" ), now++ );
+      }
+   } );
+
+   run( "GnssEpoch/Get", 1, [&]()
+   {
+      sink = tracker.Get().NumberOfSatellites;
+   } );
+
+   SENTENCE sentence;
+
+   run( "GnssEpoch/WriteMessages<GSV>", 3, [&]()
+   {
+      std::ignore = gsv[ 2 ].WriteMessages( sentence, [&]( SENTENCE const& message ) { sink = static_cast<int>( message.Text().length() ); } );
+   } );
+
+   std::ignore = sink;
+}
+
+int main( int number_of_arguments, char * arguments[] )
+{
+   if ( number_of_arguments > 1 )
+   {
+      filter = arguments[ 1 ];
+   }
+
+   printf( "{\n" );
+   printf( "  \"context\": {\n" );
+   printf( "    \"executable\": \"%s\",\n", arguments[ 0 ] );
+   printf( "    \"scan_kernel\": \"%s\",\n", scan_kernel_name() );
+#if defined( NDEBUG )
+   printf( "    \"build_type\": \"release\"\n" );
+#else
+   printf( "    \"build_type\": \"debug\"\n" );
+#endif
+   printf( "  },\n" );
+   printf( "  \"benchmarks\": [\n" );
+
+   parse_benchmarks();
+   sentence_benchmarks();
+   coordinate_benchmarks();
+   write_benchmarks();
+   ais_benchmarks();
+   record_benchmarks();
+   ingest_benchmarks();
+   vessel_state_benchmarks();
+   gnss_epoch_benchmarks();
+
+   printf( "\n  ]\n}\n" );
+
+   return( EXIT_SUCCESS );
+}
@@ -0,0 +1,134 @@
+/*
+Author: Samuel R. Blackburn
+Internet: wfc@pobox.com
+
+"You can get credit for something or get it done, but not both."
+Dr. Richard Garwin
+
+The MIT License (MIT)
+
+Copyright (c) 1996-2019 Sam Blackburn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../nmea0183.h"
+
+#include <chrono>
+
+/*
+** Measures how fast the character scanning kernel chews through sentences.
+** Run it once per kernel:
+**
+**    NMEA0183_SCAN=scalar ./scan
+**    NMEA0183_SCAN=sse2 ./scan
+**    ./scan
+*/
+
+static std::string_view const sentences[]
+{
+   STRING_VIEW("$GPHDT,274.07,T*03\r\n"),
+   STRING_VIEW("$GPVTG,054.7,T,034.4,M,000.5,N,000.9,K*47\r\n"),
+   STRING_VIEW("$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n"),
+   STRING_VIEW("$GPRMB,A,0.66,L,003,004,4917.24,N,12309.57,W,001.3,052.5,000.5,V*20\r\n"),
+   STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"),
+   STRING_VIEW("$GPGGA,103050,3912.073,N,07646.887,W,1,08,1.8,2.5,M,-34.0,M,,*72\r\n"),
+   STRING_VIEW("$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"),
+   STRING_VIEW("$LCRMA,A,4226.265,N,07125.890,W,14172.33,26026.71,8.53,275.,14.0,W*53\r\n"),
+};
+
+template <typename FUNCTION>
+static double bytes_per_nanosecond( std::size_t bytes_per_call, FUNCTION function )
+{
+   std::size_t number_of_calls{ 0 };
+
+   auto const start{ std::chrono::steady_clock::now() };
+   auto finish{ start };
+
+   do
+   {
+      for ( int loop_index{ 0 }; loop_index < 1000; loop_index++ )
+      {
+         function();
+      }
+
+      number_of_calls += 1000;
+      finish = std::chrono::steady_clock::now();
+   }
+   while( finish - start < std::chrono::milliseconds( 200 ) );
+
+   auto const nanoseconds{ std::chrono::duration<double, std::nano>( finish - start ).count() };
+
+   return( static_cast<double>( bytes_per_call * number_of_calls ) / nanoseconds );
+}
+
+int main()
+{
+   printf( "Kernel: %s\n\n", scan_kernel_name() );
+
+   volatile uint8_t sink{ 0 };
+
+   for ( auto const sentence : sentences )
+   {
+      SENTENCE tokenized;
+
+      tokenized = sentence;
+
+      auto const checksum_rate{ bytes_per_nanosecond( sentence.length(), [&]() { sink = xor_characters( sentence.data(), sentence.length() ); } ) };
+
+      auto const tokenize_rate{ bytes_per_nanosecond( sentence.length(), [&]()
+      {
+         tokenized = sentence;
+         sink = tokenized.ComputeChecksum();
+      } ) };
+
+      printf( "%2d bytes  checksum %6.2f bytes/ns  tokenize %6.2f bytes/ns  %.*s\n",
+              static_cast<int>( sentence.length() ), checksum_rate, tokenize_rate, static_cast<int>( sentence.length() - 2 ), sentence.data() );
+   }
+
+   /*
+   ** Now a batch, one SENTENCE re-used for a log's worth of lines
+   */
+
+   std::vector<std::string_view> batch;
+   std::size_t batch_bytes{ 0 };
+
+   for ( int loop_index{ 0 }; loop_index < 1000; loop_index++ )
+   {
+      batch.push_back( sentences[ loop_index % std::size( sentences ) ] );
+      batch_bytes += batch.back().length();
+   }
+
+   SENTENCE tokenized;
+
+   auto const batch_rate{ bytes_per_nanosecond( batch_bytes, [&]()
+   {
+      for ( auto const sentence : batch )
+      {
+         tokenized = sentence;
+         sink = tokenized.ComputeChecksum();
+      }
+   } ) };
+
+   printf( "\nBatch of %d sentences, %d bytes: tokenize %6.2f bytes/ns\n", static_cast<int>( batch.size() ), static_cast<int>( batch_bytes ), batch_rate );
+
+   std::ignore = sink;
+
+   return( EXIT_SUCCESS );
+}
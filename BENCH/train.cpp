@@ -0,0 +1,127 @@
+/*
+Author: Samuel R. Blackburn
+Internet: wfc@pobox.com
+
+"You can get credit for something or get it done, but not both."
+Dr. Richard Garwin
+
+The MIT License (MIT)
+
+Copyright (c) 1996-2019 Sam Blackburn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../nmea0183.h"
+
+#include <chrono>
+#include <mutex>
+#include <new>
+
+#include "../nmea0183.h"
+
+#include <fstream>
+#include <iterator>
+
+/*
+** The training run for 'make pgo'. It reads a log (BENCH/corpus.nmea by
+** default) through the framer and pushes every sentence down the paths a
+** program normally takes: parsing with and without text, borrowed, with
+** the duplicate filter, through NMEA0183_PARSER, into a vessel state and
+** the satellites of each epoch and back out again with Write(). The profile this leaves behind is what the
+** second build optimizes for, so keep the corpus looking like real traffic.
+*/
+
+int main( int number_of_arguments, char * arguments[] )
+{
+   auto const filename{ ( number_of_arguments > 1 ) ? arguments[ 1 ] : "BENCH/corpus.nmea" };
+
+   std::ifstream file( filename, std::ios::binary );
+
+   if ( file.is_open() == false )
+   {
+      fprintf( stderr, "Can't open %s\n", filename );
+      return( EXIT_FAILURE );
+   }
+
+   std::string const log{ std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() };
+
+   NMEA0183 nmea0183;
+   NMEA0183 quiet;
+   NMEA0183_PARSER<RMC, GGA, VTG, HDT, DBT, MWV, GSV, GSA> parser;
+   DUPLICATE_FILTER duplicates;
+   VESSEL_STATE_TRACKER tracker;
+   GNSS_EPOCH_TRACKER epochs;
+   SENTENCE written;
+   char buffer[ 128 ];
+   uint64_t number_of_sentences{ 0 };
+   uint64_t number_parsed{ 0 };
+
+   quiet.FillTextOnParse = false;
+   quiet.Duplicates = &duplicates;
+   parser.FillTextOnParse = false;
+
+   for ( int pass{ 0 }; pass < 20; pass++ )
+   {
+      SENTENCE_FRAMER framer;
+      std::string_view chunk( log );
+
+      while( chunk.empty() == false )
+      {
+         // Serial ports hand over a few hundred bytes at a time
+
+         chunk.remove_prefix( framer.Write( chunk.substr( 0, 512 ) ) );
+
+         std::string_view sentence;
+
+         while( framer.Next( sentence ) == true )
+         {
+            number_of_sentences++;
+
+            nmea0183 << sentence;
+
+            if ( nmea0183.Parse() == true )
+            {
+               number_parsed++;
+               tracker.Update( nmea0183 );
+               epochs.Update( nmea0183 );
+
+               auto const response{ nmea0183.GetLastResponse() };
+               SENTENCE_ENCODER encoder( buffer );
+
+               std::ignore = encoder.Encode( *response );
+               std::ignore = response->Write( written );
+            }
+
+            quiet.BorrowSentence( sentence );
+            std::ignore = quiet.Parse();
+
+            parser.BorrowSentence( sentence );
+            std::ignore = parser.Parse();
+         }
+      }
+   }
+
+   auto const state{ tracker.Get() };
+
+   printf( "Trained on %" PRIu64 " sentences, %" PRIu64 " parsed, %.1f%% repeats, last fix %.4f %.4f, %" PRIu64 " satellite epochs\n",
+           number_of_sentences, number_parsed, duplicates.Total().Rate() * 100.0, state.Position.Value.Latitude, state.Position.Value.Longitude, epochs.Get().EpochNumber );
+
+   return( EXIT_SUCCESS );
+}
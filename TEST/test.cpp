@@ -29,6 +29,11 @@ SOFTWARE.
 */
 
 #include "../nmea0183.h"
+#include "../SCAN.HPP"
+#include <thread>
+#include <fstream>
+#include <atomic>
+#include <random>
 #ifdef _WIN32
 #pragma hdrstop
 #endif
@@ -39,6 +44,12 @@ SOFTWARE.
 #pragma comment( lib, "../x64/Release/nmea0183.lib" )
 #endif
 
+#if ! defined( _WIN32 )
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
 /*
 ** This is the test scenario. Add more sentences to the list to test them
 */
@@ -143,5 +154,1818 @@ int main()
 
    std::for_each( test_sentences.cbegin(), test_sentences.cend(), testerinator );
 
+   // With FillTextOnParse turned off the text has to come from the accessors.
+   // Times without a date take it from the sentences before them, so both
+   // parsers start from scratch.
+
+   NMEA0183 eager_nmea0183;
+   NMEA0183 lazy_nmea0183;
+
+   lazy_nmea0183.FillTextOnParse = false;
+
+   for (auto const& item : test_sentences)
+   {
+       eager_nmea0183 << item.sentence;
+       lazy_nmea0183 << item.sentence;
+
+       if (eager_nmea0183.Parse() == true and lazy_nmea0183.Parse() == true)
+       {
+           if (lazy_nmea0183.PlainText.empty() == false or
+               lazy_nmea0183.GetPlainText() != eager_nmea0183.PlainText or
+               lazy_nmea0183.GetTalkerID() != eager_nmea0183.TalkerID or
+               lazy_nmea0183.GetExpandedTalkerID() != eager_nmea0183.ExpandedTalkerID)
+           {
+               printf("Failed test %d lazy text test\n", item.test_number);
+           }
+       }
+   }
+
+   // A parser that only knows a handful of sentences should agree with the full one on those.
+   // The full one only sees those too so both put dateless times on the same day.
+
+   NMEA0183_PARSER<GGA, GLL, RMC, VTG> small_parser;
+   NMEA0183 full_parser;
+
+   for (auto const& item : test_sentences)
+   {
+       auto const mnemonic{ item.sentence.substr(3, 3) };
+       auto const is_selected{ mnemonic == "GGA" or mnemonic == "GLL" or mnemonic == "RMC" or mnemonic == "VTG" };
+
+       small_parser << item.sentence;
+
+       auto const small_result{ small_parser.Parse() };
+       auto full_result{ false };
+
+       if (is_selected == true)
+       {
+           full_parser << item.sentence;
+           full_result = full_parser.Parse();
+       }
+
+       if (small_result != full_result or (small_result == true and small_parser.GetPlainText() != full_parser.PlainText))
+       {
+           printf("Failed test %d with NMEA0183_PARSER \"%s\"\n", item.test_number, small_parser.ErrorMessage.c_str());
+       }
+   }
+
+   if (sizeof(small_parser) >= sizeof(nmea0183))
+   {
+       printf("NMEA0183_PARSER is no smaller than NMEA0183\n");
+   }
+
+   // A log parsed by many threads must come out exactly like one parsed by one thread
+
+   std::string log;
+
+   for (int loop_index = 0; loop_index < 3000; loop_index++)
+   {
+       for (auto const& item : test_sentences)
+       {
+           log.append(item.sentence);
+       }
+
+       log.append(STRING_VIEW("$GPHDT,274.07,T*03\n"));
+   }
+
+   LOG_FILE single_threaded;
+   LOG_FILE multi_threaded;
+
+   single_threaded.NumberOfThreads = 1;
+   multi_threaded.NumberOfThreads = 4;
+
+   single_threaded.Parse(log);
+   multi_threaded.Parse(log);
+
+   if (single_threaded.NumberOfLines != 3000 * (test_sentences.size() + 1) or
+       single_threaded.Rmc.Offset.size() != 3000 * 2 or
+       single_threaded.Rmc.Time.front() != 785285686.0 or
+       single_threaded.Hdt.DegreesTrue.size() != 3000 or
+       single_threaded.Rmc.Offset != multi_threaded.Rmc.Offset or
+       single_threaded.Rmc.Time != multi_threaded.Rmc.Time or
+       single_threaded.Gga.Latitude != multi_threaded.Gga.Latitude or
+       single_threaded.Vtg.SpeedKnots != multi_threaded.Vtg.SpeedKnots or
+       single_threaded.Hdt.Offset != multi_threaded.Hdt.Offset or
+       single_threaded.NumberOfSentencesParsed != multi_threaded.NumberOfSentencesParsed)
+   {
+       printf("LOG_FILE test failed, %d lines, %d sentences parsed\n", (int) multi_threaded.NumberOfLines, (int) multi_threaded.NumberOfSentencesParsed);
+   }
+
+   // Now dribble the same sentences through the framer a few bytes at a time,
+   // with line noise, a truncated sentence and a bare LF thrown in
+
+   std::string stream(STRING_VIEW("noise$GPGLL,4916.4"));
+
+   for (auto const& item : test_sentences)
+   {
+       stream.append(item.sentence);
+   }
+
+   stream.append(STRING_VIEW("$GPGLL,4916.45,N,12311.12,W*71\n"));
+
+   SENTENCE_FRAMER framer;
+   std::string_view chunk(stream);
+   std::size_t number_of_sentences{ 0 };
+
+   while (chunk.empty() == false)
+   {
+       chunk.remove_prefix(framer.Write(chunk.substr(0, 7)));
+
+       std::string_view sentence;
+
+       while (framer.Next(sentence) == true)
+       {
+           auto const& item{ number_of_sentences < test_sentences.size() ? test_sentences[number_of_sentences] : NMEA_TEST{ 41, sentence, true } };
+
+           if (sentence.compare(item.sentence) != 0 and item.test_number != 41)
+           {
+               printf("Framer test failed, expected test %d\n", item.test_number);
+           }
+
+           nmea0183 << sentence;
+
+           if (nmea0183.Parse() != item.expected_parse_result)
+           {
+               printf("Framer test failed to parse test %d with \"%s\"\n", item.test_number, nmea0183.ErrorMessage.c_str());
+           }
+
+           number_of_sentences++;
+       }
+   }
+
+   if (number_of_sentences != test_sentences.size() + 1 or framer.NumberOfTruncatedSentences != 1 or framer.NumberOfDroppedBytes != 18)
+   {
+       printf("Framer test failed, %d sentences, %d truncated, %d bytes dropped\n", (int) number_of_sentences, (int) framer.NumberOfTruncatedSentences, (int) framer.NumberOfDroppedBytes);
+   }
+
+   // The encoder has to produce the same bytes as Write() into a SENTENCE
+
+   RESPONSE const * const responses[]{ &nmea0183.Aam, &nmea0183.Apb, &nmea0183.Bwc, &nmea0183.Fsi, &nmea0183.Gga, &nmea0183.Gll, &nmea0183.Proprietary, &nmea0183.Rma, &nmea0183.Rmb, &nmea0183.Rmc, &nmea0183.Vtg, &nmea0183.Wpl };
+
+   for (auto const& item : test_sentences)
+   {
+       nmea0183 << item.sentence;
+       nmea0183.Parse();
+
+       for (auto const response : responses)
+       {
+           SENTENCE sentence;
+           char buffer[ 128 ];
+           SENTENCE_ENCODER encoder(buffer);
+
+           response->Write(sentence);
+
+           if (encoder.Encode(*response) == false or encoder.Get().compare(sentence.Text()) != 0)
+           {
+               printf("Encoder test %d failed for %s, \"%s\"\n", item.test_number, response->Mnemonic.c_str(), std::string(sentence).c_str());
+           }
+       }
+   }
+
+   char small_buffer[ 10 ];
+   SENTENCE_ENCODER small_encoder(small_buffer);
+
+   if (small_encoder.Encode(nmea0183.Gga) == true or small_encoder.Get().length() > std::size(small_buffer))
+   {
+       printf("Encoder overflow test failed\n");
+   }
+
+   // Written field by field, or handed to Write() as a SENTENCE&, it is still the same bytes
+
+   SENTENCE by_hand;
+   char by_hand_buffer[ 32 ];
+   SENTENCE_ENCODER by_hand_encoder(by_hand_buffer);
+
+   by_hand = STRING_VIEW("$GPHDT");
+   by_hand += 274.07;
+   by_hand += STRING_VIEW("T");
+   by_hand.Finish();
+
+   by_hand_encoder = STRING_VIEW("$GPHDT");
+   by_hand_encoder += 274.07;
+   by_hand_encoder += STRING_VIEW("T");
+   by_hand_encoder.Finish();
+
+   auto const same_by_hand{ by_hand_encoder.Get() == by_hand.Text() };
+
+   std::ignore = nmea0183.Hdt.Write(by_hand);
+
+   if (same_by_hand == false or nmea0183.Hdt.Write(by_hand_encoder) == false or by_hand_encoder.Get() != by_hand.Text())
+   {
+       printf("Encoder operator test failed, \"%s\"\n", std::string(by_hand_encoder.Get()).c_str());
+   }
+
+   for (double value = -1000.0; value < 20000.0; value += 0.0625 * 13.0)
+   {
+       char expected[ 80 ];
+       char actual[ 80 ];
+
+       for (auto const& format : { std::make_tuple("%.3f", 3, 0), std::make_tuple("%07.2f", 2, 7), std::make_tuple("%08.2f", 2, 8) })
+       {
+           auto const expected_length{ ::sprintf(expected, std::get<0>(format), value) };
+           auto const actual_length{ format_fixed(actual, std::size(actual), value, std::get<1>(format), std::get<2>(format)) };
+
+           if (std::string_view(expected, expected_length).compare(std::string_view(actual, actual_length)) != 0)
+           {
+               printf("format_fixed(%s) failed, \"%s\"\n", std::get<0>(format), expected);
+           }
+       }
+   }
+
+   // Coordinates read as integers must come out the same as through a double
+
+   for (double value = 0.0; value < 18000.0; value += 0.0625 * 17.3)
+   {
+       char field[ 80 ];
+
+       auto const field_length{ ::sprintf(field, "%.4f", value) };
+
+       FIXED_ANGLE angle;
+       LATITUDE by_double;
+       LATITUDE by_sentence;
+       SENTENCE sentence;
+
+       by_double.Set(std::strtod(field, nullptr), STRING_VIEW("S"));
+
+       sentence = STRING_VIEW("$GPGLL");
+       sentence += std::string_view(field, field_length);
+       sentence += STRING_VIEW("S");
+
+       by_sentence.Parse(1, 2, sentence);
+
+       if (parse_angle(std::string_view(field, field_length), angle) == false or
+           by_sentence.Latitude != by_double.Latitude or
+           by_sentence.Coordinate != by_double.Coordinate or
+           by_sentence.GetWholeDegrees() != by_double.GetWholeDegrees() or
+           fabs(by_sentence.GetDecimalDegrees() - by_double.GetDecimalDegrees()) > 1.0e-9 or
+           fabs(by_sentence.GetDecimalMinutes() - by_double.GetDecimalMinutes()) > 1.0e-7 or
+           by_sentence.GetSignedMicrodegrees() != by_double.GetSignedMicrodegrees() or
+           by_sentence.GetSignedDecimalDegrees() > 0.0)
+       {
+           printf("Fixed point coordinate test failed for %s\n", field);
+       }
+   }
+
+   std::string_view const angle_fields[]{ "4807.038", "01131.000", "", "12.5e3", "3959.9999999999", "17959.99999" };
+   std::string_view const hemisphere_fields[]{ "N", "W", "N", "S", "S", "E" };
+   double angle_degrees[ std::size(angle_fields) ];
+   int32_t angle_microdegrees[ std::size(angle_fields) ];
+
+   if (angles_to_degrees(angle_fields, hemisphere_fields, std::size(angle_fields), angle_degrees) != 5 or
+       angles_to_microdegrees(angle_fields, hemisphere_fields, std::size(angle_fields), angle_microdegrees) != 5 or
+       fabs(angle_degrees[ 0 ] - 48.1173) > 1.0e-12 or angle_microdegrees[ 0 ] != 48117300 or
+       fabs(angle_degrees[ 1 ] + 11.516666666666667) > 1.0e-12 or angle_microdegrees[ 1 ] != -11516667 or
+       angle_degrees[ 2 ] != 0.0 or angle_microdegrees[ 2 ] != 0 or
+       std::isnan(angle_degrees[ 3 ]) == false or angle_microdegrees[ 3 ] != std::numeric_limits<int32_t>::min() or
+       angle_microdegrees[ 4 ] != -40000000 or angle_microdegrees[ 5 ] != 180000000)
+   {
+       printf("Angle conversion test failed\n");
+   }
+
+   nmea0183 << STRING_VIEW("$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n");
+
+   if (nmea0183.Parse() == true)
+   {
+       LATLONG position;
+
+       position = nmea0183.Gll.Position;
+
+       if (position.Latitude.GetSignedMicrodegrees() != 49274167 or position.Longitude.GetSignedMicrodegrees() != -123185333 or position.Longitude.GetWholeDegrees() != 123)
+       {
+           printf("Cached coordinate test failed\n");
+       }
+   }
+   else
+   {
+       printf("Cached coordinate test failed with \"%s\"\n", nmea0183.ErrorMessage.c_str());
+   }
+
+   // The time kernel against the C library, every day from 1600 to 2400 and every ddmmyy
+
+   auto const library_timegm = [](int year, int month, int day, int hour, int minute, int second)
+   {
+       struct tm broken_down_time{};
+
+       broken_down_time.tm_year = year - 1900;
+       broken_down_time.tm_mon  = month;
+       broken_down_time.tm_mday = day;
+       broken_down_time.tm_hour = hour;
+       broken_down_time.tm_min  = minute;
+       broken_down_time.tm_sec  = second;
+
+#if defined( _WIN32 )
+       return(_mkgmtime(&broken_down_time));
+#else
+       return(timegm(&broken_down_time));
+#endif
+   };
+
+   static_assert(days_from_civil(1970, 1, 1) == 0 and days_from_civil(2000, 3, 1) == 11017 and days_from_civil(1969, 12, 31) == -1);
+
+   int number_of_time_failures{ 0 };
+
+   for (int year = 1600; year < 2400; year++)
+   {
+       for (int month = -1; month < 13; month++)
+       {
+           for (int day = 1; day < 32; day++)
+           {
+               if (ctime(year, month, day, 23, 59, 59) != library_timegm(year, month, day, 23, 59, 59))
+               {
+                   number_of_time_failures++;
+               }
+           }
+       }
+   }
+
+   for (int year = 0; year < 100; year++)
+   {
+       for (int month = 1; month < 13; month++)
+       {
+           for (int day = 1; day < 32; day++)
+           {
+               char ddmmyy[ 8 ];
+               int64_t days{ 0 };
+
+               ::sprintf(ddmmyy, "%02d%02d%02d", day, month, year);
+
+               // Days past the end of the month come back from timegm() in the next month
+
+               auto const seconds{ library_timegm((year < 80) ? 2000 + year : 1900 + year, month - 1, day, 0, 0, 0) };
+               auto const is_real_date{ universal_time(seconds).tm_mday == day };
+
+               if (parse_date(ddmmyy, days) != is_real_date or (is_real_date == true and days * 86400 != seconds))
+               {
+                   number_of_time_failures++;
+               }
+           }
+       }
+   }
+
+   for (int second = 0; second < 86400; second++)
+   {
+       char hhmmss[ 16 ];
+       int64_t nanoseconds{ 0 };
+
+       ::sprintf(hhmmss, "%02d%02d%02d.%03d", second / 3600, (second / 60) % 60, second % 60, second % 1000);
+
+       if (parse_time_of_day(hhmmss, nanoseconds) == false or nanoseconds != (second * nanoseconds_per_second) + ((second % 1000) * 1000000))
+       {
+           number_of_time_failures++;
+       }
+   }
+
+   int64_t rejected{ 0 };
+
+   if (number_of_time_failures != 0 or parse_date("300280", rejected) == true or parse_date("311399", rejected) == true or parse_date("3112", rejected) == true or
+       parse_time_of_day("240000", rejected) == true or parse_time_of_day("12:30:00", rejected) == true or parse_time_of_day("123000.5x", rejected) == true)
+   {
+       printf("Time kernel test failed %d times\n", number_of_time_failures);
+   }
+
+   // Dates come from RMC and ZDA, a GGA after midnight rolls over to the next day
+
+   NMEA0183 time_parser;
+
+   time_parser << STRING_VIEW("$GPZDA,201530.25,04,07,2002,00,00*67\r\n");
+
+   if (time_parser.Parse() == false or time_parser.Zda.Time != 1025813730 or time_parser.Zda.Timestamp != INT64_C(1025813730250000000))
+   {
+       printf("ZDA time test failed\n");
+   }
+
+   time_parser << STRING_VIEW("$GPRMC,235959.50,A,4916.45,N,12311.12,W,000.5,054.7,311299,020.3,E*45\r\n");
+
+   if (time_parser.Parse() == false or time_parser.Rmc.Time != 946684799 or time_parser.Rmc.Timestamp != INT64_C(946684799500000000))
+   {
+       printf("RMC time test failed\n");
+   }
+
+   time_parser << STRING_VIEW("$GPGGA,000000.20,4916.45,N,12311.12,W,1,08,0.9,545.4,M,46.9,M,,*7E\r\n");
+
+   if (time_parser.Parse() == false or time_parser.Gga.Time != 946684800 or time_parser.Gga.Timestamp != INT64_C(946684800200000000))
+   {
+       printf("GGA date rollover test failed\n");
+   }
+
+   time_parser << STRING_VIEW("$GPGGA,235959.90,4916.45,N,12311.12,W,1,08,0.9,545.4,M,46.9,M,,*74\r\n");
+
+   if (time_parser.Parse() == false or time_parser.Gga.Timestamp != INT64_C(946684799900000000))
+   {
+       printf("GGA late fix test failed\n");
+   }
+
+   // Tag blocks, the date comes from c: even when the fix is from the other side of midnight
+
+   nmea0183 << STRING_VIEW("\\s:GPS1,c:1697500000*45\\$GPGGA,235959,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4B\r\n");
+
+   if (nmea0183.Parse() == false or nmea0183.GetTagBlock().Source != "GPS1" or nmea0183.GetTagBlock().Time != 1697500000 or nmea0183.Gga.Time != 1697500799)
+   {
+       printf("Tag block test failed with \"%s\"\n", nmea0183.ErrorMessage.c_str());
+   }
+
+   std::string tagged_stream(STRING_VIEW("\\c:1697500799000,n:12,g:1-2-34,s:GPS1*7C\\$GPGGA,000001,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4B\r\n"));
+
+   tagged_stream.append(STRING_VIEW("\\c:1697500799000,n:12,g:1-2-34,s:GPS1*7D\\$GPGGA,000001,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4B\r\n"));
+
+   SENTENCE_FRAMER tag_block_framer;
+   std::string_view tagged_sentence;
+
+   tag_block_framer.Write(tagged_stream);
+
+   if (tag_block_framer.Next(tagged_sentence) == false)
+   {
+       printf("Tag block framer test failed\n");
+   }
+
+   nmea0183 << tagged_sentence;
+
+   auto const& tag_block{ nmea0183.GetTagBlock() };
+
+   if (nmea0183.Parse() == false or tag_block.Time != 1697500799 or tag_block.Milliseconds != 0 or tag_block.LineCount != 12 or
+       tag_block.GroupSentenceNumber != 1 or tag_block.GroupNumberOfSentences != 2 or tag_block.GroupID != 34 or nmea0183.Gga.Time != 1697500801)
+   {
+       printf("Tag block test failed with \"%s\"\n", nmea0183.ErrorMessage.c_str());
+   }
+
+   if (tag_block_framer.Next(tagged_sentence) == false)
+   {
+       printf("Tag block framer test failed\n");
+   }
+
+   nmea0183 << tagged_sentence;
+
+   if (nmea0183.Parse() == true)
+   {
+       printf("Tag block test failed, a bad tag block checksum was accepted\n");
+   }
+
+   // AIS, a two fragment type 5 with a position report in between on the other channel
+
+   std::string_view const ais_sentences[]
+   {
+       STRING_VIEW("!AIVDM,2,1,1,A,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0*1C\r\n"),
+       STRING_VIEW("!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"),
+       STRING_VIEW("!AIVDM,2,2,1,A,88888888880,2*25\r\n"),
+   };
+
+   for (auto const sentence : ais_sentences)
+   {
+       nmea0183 << sentence;
+
+       if (nmea0183.Parse() == false)
+       {
+           printf("AIS test failed with \"%s\"\n", nmea0183.ErrorMessage.c_str());
+       }
+
+       if (nmea0183.Vdm.IsComplete == true and nmea0183.Vdm.Message.MessageType == 1)
+       {
+           auto const& report{ nmea0183.Vdm.Message.PositionReport };
+
+           if (nmea0183.Vdm.Message.MMSI != 477553000 or report.NavigationStatus != 5 or report.TrueHeading != 181 or
+               ::fabs(report.Latitude - 47.582833) > 0.000001 or ::fabs(report.Longitude + 122.345833) > 0.000001 or ::fabs(report.CourseOverGroundDegreesTrue - 51.0) > 0.01)
+           {
+               printf("AIS position report test failed, %s\n", nmea0183.GetPlainText().c_str());
+           }
+       }
+   }
+
+   auto const& voyage{ nmea0183.Vdm.Message.StaticAndVoyageData };
+
+   if (nmea0183.Vdm.IsComplete == false or nmea0183.Vdm.Message.MessageType != 5 or nmea0183.Vdm.Message.MMSI != 351759000 or
+       voyage.IMONumber != 9134270 or voyage.CallSign != "3FOF8" or voyage.VesselName != "EVER DIADEM" or voyage.Destination != "NEW YORK" or
+       voyage.ShipType != 70 or voyage.ETAMonth != 5 or voyage.ETADay != 15 or voyage.ETAHour != 14 or ::fabs(voyage.DraughtMeters - 12.2) > 0.01)
+   {
+       printf("AIS static and voyage data test failed, %s\n", nmea0183.GetPlainText().c_str());
+   }
+
+   nmea0183 << ais_sentences[ 2 ];
+
+   if (nmea0183.Parse() == true)
+   {
+       printf("AIS test failed, a second fragment without a first was accepted\n");
+   }
+
+   nmea0183 << ais_sentences[ 1 ];
+   nmea0183.Parse();
+
+   SENTENCE ais_sentence;
+
+   nmea0183.Vdm.DataSource = STRING_VIEW("AI");
+   nmea0183.Vdm.Write(ais_sentence);
+
+   if (ais_sentence.Text().compare(ais_sentences[ 1 ]) != 0)
+   {
+       printf("AIS write test failed, %s\n", std::string(ais_sentence).c_str());
+   }
+
+   // Class B, a type 18 position report, a type 19 extended report and both parts of a type 24
+
+   {
+       NMEA0183 class_b_parser;
+       auto const& message{ class_b_parser.Vdm.Message };
+
+       class_b_parser << STRING_VIEW("!AIVDM,1,1,,A,B5NJ;PP005l4ot5Isbl03wsUkP06,0*76\r\n");
+
+       auto const& report{ message.ClassBPositionReport };
+
+       if (class_b_parser.Parse() == false or message.MessageType != 18 or message.MMSI != 367430530 or report.SpeedOverGroundKnots != 0.0 or
+           ::fabs(report.Latitude - 37.785035) > 0.000001 or ::fabs(report.Longitude + 122.26732) > 0.000001 or report.TrueHeading != 511 or
+           report.TimeStamp != 55 or report.IsCarrierSense == false or report.HasDisplay == true or report.HasDSC == false or
+           report.CanUseWholeBand == false or report.CanUseMessage22 == false or report.IsAssigned == true or report.RAIM == true or report.RadioStatus != 917510)
+       {
+           printf("AIS type 18 test failed, %s\n", class_b_parser.GetErrorMessage().c_str());
+       }
+
+       class_b_parser << STRING_VIEW("!AIVDM,1,1,,B,C5N3SRgPEnJGEBT>NhWAwwo862PaLELTBJ:V00000000S0D:R220,0*0B\r\n");
+
+       if (class_b_parser.Parse() == false or message.MessageType != 19 or message.MMSI != 367059850 or report.SpeedOverGroundKnots != 8.7 or
+           ::fabs(report.Latitude - 29.543695) > 0.000001 or ::fabs(report.Longitude + 88.810392) > 0.000001 or report.CourseOverGroundDegreesTrue != 335.9 or
+           report.TimeStamp != 46 or report.VesselName != "CAPT.J.RIMES" or report.ShipType != 70 or report.DimensionToBow != 5 or
+           report.DimensionToStern != 21 or report.DimensionToPort != 4 or report.DimensionToStarboard != 4 or report.PositionFixType != 1 or
+           report.IsDataTerminalReady == false)
+       {
+           printf("AIS type 19 test failed, %s\n", class_b_parser.GetErrorMessage().c_str());
+       }
+
+       auto const& static_data{ message.StaticDataReport };
+
+       class_b_parser << STRING_VIEW("!AIVDM,1,1,,A,H42O55i18tMET00000000000000,2*6D\r\n");
+
+       if (class_b_parser.Parse() == false or message.MessageType != 24 or message.MMSI != 271041815 or static_data.PartNumber != 0 or
+           static_data.VesselName != "PROGUY")
+       {
+           printf("AIS type 24 part A test failed, %s\n", class_b_parser.GetErrorMessage().c_str());
+       }
+
+       class_b_parser << STRING_VIEW("!AIVDM,1,1,,A,H42O55lti4hhhilD3nink000?050,0*40\r\n");
+
+       if (class_b_parser.Parse() == false or message.MessageType != 24 or message.MMSI != 271041815 or static_data.PartNumber != 1 or
+           static_data.ShipType != 60 or static_data.VendorID != "1D0" or static_data.UnitModelCode != 12 or static_data.SerialNumber != 199796 or
+           static_data.CallSign != "TC6163" or static_data.DimensionToBow != 0 or static_data.DimensionToStern != 15 or
+           static_data.DimensionToPort != 0 or static_data.DimensionToStarboard != 5 or static_data.MothershipMMSI != 0)
+       {
+           printf("AIS type 24 part B test failed, %s\n", class_b_parser.GetErrorMessage().c_str());
+       }
+   }
+
+   // Error codes, the text only when asked for, and statistics shared between threads
+
+   PARSE_STATISTICS statistics;
+   NMEA0183 quiet_parser;
+
+   quiet_parser.FillTextOnParse = false;
+   quiet_parser.Statistics = &statistics;
+
+   quiet_parser << STRING_VIEW("$GPHDT,274.07,T*04\r\n");
+
+   if (quiet_parser.Parse() == true or quiet_parser.ErrorCode != NMEA0183_ERROR::InvalidChecksum or
+       quiet_parser.ErrorMessage.empty() == false or quiet_parser.GetErrorMessage() != "HDT, Invalid Checksum")
+   {
+       printf("Error code test failed for a bad checksum\n");
+   }
+
+   quiet_parser << STRING_VIEW("$GPXYZ,1,2*00\r\n");
+
+   if (quiet_parser.Parse() == true or quiet_parser.ErrorCode != NMEA0183_ERROR::UnknownSentence or quiet_parser.GetErrorMessage() != "Unknown type of sentence")
+   {
+       printf("Error code test failed for an unknown sentence\n");
+   }
+
+   quiet_parser << STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E\r\n");
+
+   if (quiet_parser.Parse() == true or quiet_parser.ErrorCode != NMEA0183_ERROR::MissingChecksum)
+   {
+       printf("Error code test failed for a missing checksum\n");
+   }
+
+   // Checksums are optional, a sentence without one still parses but is counted
+
+   quiet_parser << STRING_VIEW("$GPHDT,274.07,T\r\n");
+
+   if (quiet_parser.Parse() == false)
+   {
+       printf("Error code test failed without a checksum\n");
+   }
+
+   small_parser.FillTextOnParse = false;
+   small_parser.Statistics = &statistics;
+   small_parser << STRING_VIEW("$GPHDT,274.07,T*03\r\n");
+
+   if (small_parser.Parse() == true or small_parser.ErrorCode != NMEA0183_ERROR::UnknownSentence or small_parser.ErrorMessage.empty() == false)
+   {
+       printf("Error code test failed with NMEA0183_PARSER\n");
+   }
+
+   small_parser << STRING_VIEW("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*48\r\n");
+
+   if (small_parser.Parse() == true or small_parser.ErrorCode != NMEA0183_ERROR::InvalidChecksum or small_parser.GetErrorMessage() != "GGA, Invalid Checksum")
+   {
+       printf("Error code test failed with NMEA0183_PARSER\n");
+   }
+
+   std::vector<std::thread> statistics_threads;
+
+   for (int thread_index = 0; thread_index < 4; thread_index++)
+   {
+       statistics_threads.emplace_back([&statistics]()
+       {
+           NMEA0183 parser;
+
+           parser.FillTextOnParse = false;
+           parser.Statistics = &statistics;
+
+           for (int loop_index = 0; loop_index < 1000; loop_index++)
+           {
+               parser << STRING_VIEW("$GPHDT,274.07,T*03\r\n");
+               std::ignore = parser.Parse();
+               parser << STRING_VIEW("$HCHDT,274.07,T*03\r\n");
+               std::ignore = parser.Parse();
+           }
+       });
+   }
+
+   for (auto& thread : statistics_threads)
+   {
+       thread.join();
+   }
+
+   uint64_t number_of_latencies{ 0 };
+
+   for (auto const& bucket : statistics.Total().LatencyHistogram)
+   {
+       number_of_latencies += bucket.load();
+   }
+
+   if (statistics.Mnemonic("HDT").Parsed != 4001 or statistics.Mnemonic("HDT").InvalidChecksum != 4001 or statistics.Mnemonic("HDT").MissingChecksum != 1 or
+       statistics.Mnemonic("XYZ").Unknown != 1 or statistics.Mnemonic("RMC").MissingChecksum != 1 or statistics.Mnemonic("RMC").OtherErrors != 1 or
+       statistics.Mnemonic("GGA").InvalidChecksum != 1 or statistics.Talker("GP").Parsed != 4001 or statistics.Total().MissingChecksum != 2 or
+       statistics.Talker("HC").InvalidChecksum != 4000 or statistics.Total().Bytes != 8002 * 20 + 15 + 65 + 67 + 17 or
+       number_of_latencies != 8006 or statistics.Mnemonics() != std::vector<std::string>{ "GGA", "HDT", "RMC", "XYZ" })
+   {
+       printf("Statistics test failed\n");
+   }
+
+   // Subscribers only see what they asked for, everything else is turned
+   // away before its checksum is looked at
+
+   {
+       NMEA0183 subscribed_parser;
+       NMEA0183_PARSER<RMC, GGA, HDT> small_subscribed_parser;
+       PARSE_STATISTICS subscription_statistics;
+
+       subscribed_parser.Statistics = &subscription_statistics;
+
+       int number_of_headings{ 0 };
+       int number_of_fixes{ 0 };
+       int number_of_small_fixes{ 0 };
+       auto right_object{ true };
+
+       if (subscribed_parser.Subscribe<HDT>([&](HDT const& hdt) { number_of_headings++; right_object = right_object and &hdt == &subscribed_parser.Hdt and hdt.DegreesTrue == 274.07; }) == false or
+           subscribed_parser.Subscribe<RMC>([&](RMC const& rmc) { number_of_fixes++; right_object = right_object and &rmc == &subscribed_parser.Rmc; }, { "GP", "GN" }) == false)
+       {
+           printf("Subscribe test failed\n");
+       }
+
+       // Talkers that are all misspelled subscribe nothing rather than everything
+
+       if (small_subscribed_parser.Subscribe<RMC>([&](RMC const&) { number_of_small_fixes++; }, { "GN" }) == false or
+           small_subscribed_parser.Subscribe<GGA>([&](GGA const&) { number_of_small_fixes++; }, { "G", "GPS" }) == true or
+           subscribed_parser.Subscribe<GGA>([&](GGA const&) { number_of_fixes++; }, { "" }) == true)
+       {
+           printf("Subscribe talker test failed\n");
+       }
+
+       struct
+       {
+           std::string_view sentence;
+           NMEA0183_ERROR expected;
+           NMEA0183_ERROR expected_by_small_parser;
+       }
+       const subscription_sentences[]
+       {
+           { STRING_VIEW("$GPHDT,274.07,T*03\r\n"), NMEA0183_ERROR::NoError, NMEA0183_ERROR::NotSubscribed },
+           { STRING_VIEW("$GPHDT,274.07,T*04\r\n"), NMEA0183_ERROR::InvalidChecksum, NMEA0183_ERROR::NotSubscribed },
+           { STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"), NMEA0183_ERROR::NoError, NMEA0183_ERROR::NotSubscribed },
+           { STRING_VIEW("$GNRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*76\r\n"), NMEA0183_ERROR::NoError, NMEA0183_ERROR::NoError },
+           { STRING_VIEW("$GLRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*74\r\n"), NMEA0183_ERROR::NotSubscribed, NMEA0183_ERROR::NotSubscribed },
+           { STRING_VIEW("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*00\r\n"), NMEA0183_ERROR::NotSubscribed, NMEA0183_ERROR::NotSubscribed },
+           { STRING_VIEW("$GPXYZ,1,2*00\r\n"), NMEA0183_ERROR::NotSubscribed, NMEA0183_ERROR::NotSubscribed },
+       };
+
+       for (auto const& item : subscription_sentences)
+       {
+           subscribed_parser << item.sentence;
+           std::ignore = subscribed_parser.Parse();
+           small_subscribed_parser << item.sentence;
+           std::ignore = small_subscribed_parser.Parse();
+
+           if (subscribed_parser.ErrorCode != item.expected or small_subscribed_parser.ErrorCode != item.expected_by_small_parser)
+           {
+               printf("Subscription test failed with %s", std::string(item.sentence).c_str());
+           }
+       }
+
+       subscribed_parser.Unsubscribe();
+       subscribed_parser << STRING_VIEW("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*00\r\n");
+
+       if (number_of_headings != 1 or number_of_fixes != 2 or number_of_small_fixes != 1 or right_object == false or
+           subscribed_parser.Parse() == true or subscribed_parser.ErrorCode != NMEA0183_ERROR::InvalidChecksum or
+           subscription_statistics.Total().NotSubscribed != 3 or subscription_statistics.Mnemonic("GGA").NotSubscribed != 1)
+       {
+           printf("Subscription test failed, %d headings and %d fixes\n", number_of_headings, number_of_fixes);
+       }
+   }
+
+   // Exact repeats aren't decoded again while the sentence object still
+   // holds them
+
+   {
+       NMEA0183 repeat_parser;
+       NMEA0183_PARSER<RMC, HDT> small_repeat_parser;
+       DUPLICATE_FILTER duplicates;
+       DUPLICATE_FILTER small_duplicates;
+       int number_of_headings{ 0 };
+       int number_of_fixes{ 0 };
+
+       repeat_parser.Duplicates = &duplicates;
+       small_repeat_parser.Duplicates = &small_duplicates;
+       std::ignore = repeat_parser.Subscribe<HDT>([&](HDT const&) { number_of_headings++; });
+       std::ignore = repeat_parser.Subscribe<RMC>([&](RMC const&) { number_of_fixes++; });
+
+       struct
+       {
+           std::string_view sentence;
+           bool parses;
+           bool is_unchanged;
+       }
+       const repeat_sentences[]
+       {
+           { STRING_VIEW("$GPHDT,274.07,T*03\r\n"), true, false },
+           { STRING_VIEW("$GPHDT,274.07,T*03\r\n"), true, true },
+           { STRING_VIEW("$GPHDT,274.07,T*04\r\n"), false, false },
+           { STRING_VIEW("$GPHDT,274.07,T*03\r\n"), true, false },
+           { STRING_VIEW("$GPHDT,274.07,T*03\r\n"), true, true },
+           { STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"), true, false },
+           { STRING_VIEW("$GNRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*76\r\n"), true, false },
+           { STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"), true, false },
+           { STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"), true, true },
+       };
+
+       for (auto const& item : repeat_sentences)
+       {
+           repeat_parser << item.sentence;
+           small_repeat_parser << item.sentence;
+
+           if (repeat_parser.Parse() != item.parses or repeat_parser.IsUnchanged != item.is_unchanged or
+               small_repeat_parser.Parse() != item.parses or small_repeat_parser.IsUnchanged != item.is_unchanged)
+           {
+               printf("Duplicate test failed with %s", std::string(item.sentence).c_str());
+           }
+       }
+
+       if (repeat_parser.Rmc.Position.Latitude.Latitude != 4916.45 or repeat_parser.GetTalkerID() != "GP" or
+           repeat_parser.LastSentenceIDParsed != "RMC" or small_repeat_parser.Get<HDT>().DegreesTrue != 274.07)
+       {
+           printf("Duplicate test failed, sentence objects were changed\n");
+       }
+
+       // Past the window it is decoded again
+
+       duplicates.Window = std::chrono::nanoseconds(0);
+       repeat_parser << STRING_VIEW("$GPHDT,274.07,T*03\r\n");
+
+       if (repeat_parser.Parse() == false or repeat_parser.IsUnchanged == true or number_of_headings != 3 or number_of_fixes != 3 or
+           duplicates.Total().Sentences != 10 or duplicates.Total().Duplicates != 3 or
+           duplicates.Get("HDT", "GP").Sentences != 6 or duplicates.Get("HDT", "GP").Duplicates != 2 or
+           duplicates.Get("RMC", "GN").Sentences != 1 or duplicates.Get("RMC", "GN").Duplicates != 0 or
+           duplicates.Get("RMC", "GP").Duplicates != 1 or duplicates.Get("RMC", "GL").Sentences != 0 or
+           small_duplicates.Total().Rate() != 3.0 / 9.0)
+       {
+           printf("Duplicate test failed, %d headings\n", number_of_headings);
+       }
+
+       duplicates.Clear();
+
+       if (duplicates.Total().Sentences != 0 or duplicates.Get("HDT", "GP").Sentences != 0)
+       {
+           printf("Duplicate test failed to clear\n");
+       }
+   }
+
+   // Archive an hour of fixes that runs over midnight as records, then
+   // replay windows of it with and without the index
+
+   auto const with_checksum{ [](std::string const& body)
+   {
+       uint8_t checksum{ 0 };
+
+       for (auto const character : std::string_view(body).substr(1))
+       {
+           checksum ^= static_cast<uint8_t>(character);
+       }
+
+       char tail[8]{};
+       snprintf(tail, std::size(tail), "*%02X\r\n", checksum);
+       return(body + tail);
+   } };
+
+   std::string record_log;
+
+   for (int second = 0; second < 3600; second++)
+   {
+       auto const time_of_day{ (84600 + second) % 86400 };
+       char time_text[16]{};
+       char body[128]{};
+
+       snprintf(time_text, std::size(time_text), "%02d%02d%02d.%02d", time_of_day / 3600, (time_of_day / 60) % 60, time_of_day % 60, second % 100);
+
+       snprintf(body, std::size(body), "$GPRMC,%s,A,4916.%04d,S,12311.%04d,W,000.5,054.7,%s,020.3,E", time_text, second, 3600 - second, (second < 1800) ? "181023" : "191023");
+       record_log += with_checksum(body);
+       snprintf(body, std::size(body), "$GPGGA,%s,4807.%03d,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,", time_text, second % 1000);
+       record_log += with_checksum(body);
+       snprintf(body, std::size(body), "$HEHDT,%d.5,T", second % 360);
+       record_log += with_checksum(body);
+
+       if ((second % 2) == 0)
+       {
+           record_log += with_checksum("$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K");
+       }
+
+       if ((second % 3) == 0)
+       {
+           snprintf(body, std::size(body), "$SDDBT,%d.0,f,%d.0,M,0.0,F", second, second);
+           record_log += with_checksum(body);
+       }
+   }
+
+   record_log.resize(record_log.length() - 2); // No line ending on the last line
+
+   NMEA0183_PARSER<RMC, GGA, HDT> record_parser;
+   std::vector<std::string> rmc_sentences;
+   std::vector<int64_t> parsed_gga_timestamps;
+
+   for (std::size_t line_start = 0; line_start < record_log.length(); )
+   {
+       auto const line_end{ std::min(record_log.find('\n', line_start), record_log.length()) };
+       auto line{ record_log.substr(line_start, line_end - line_start) };
+
+       if (line.back() != '\r')
+       {
+           line += "\r";
+       }
+
+       record_parser << line + "\n";
+
+       if (record_parser.Parse() == true and record_parser.LastSentenceIDParsed == "RMC")
+       {
+           rmc_sentences.push_back(line + "\n");
+       }
+       else if (record_parser.LastSentenceIDParsed == "GGA")
+       {
+           parsed_gga_timestamps.push_back(record_parser.Get<GGA>().Timestamp);
+       }
+
+       line_start = line_end + 1;
+   }
+
+   std::string const record_filename{ "test_records.bin" };
+   std::string const unindexed_filename{ "test_records_unindexed.bin" };
+
+   RECORD_WRITER record_writer;
+
+   record_writer.RecordsPerBlock = 64;
+
+   if (record_writer.Open(record_filename) == false or record_writer.AddLog(record_log) != 3600 * 3 + 1800 + 1200 or record_writer.Close() == false)
+   {
+       printf("Record writer test failed\n");
+   }
+
+   {
+       // The same file as if the program died before Close()
+
+       std::ifstream whole_file(record_filename, std::ios::binary);
+       std::string const bytes{ std::istreambuf_iterator<char>(whole_file), std::istreambuf_iterator<char>() };
+       std::ofstream cut_short(unindexed_filename, std::ios::binary);
+
+       cut_short.write(bytes.data(), static_cast<std::streamsize>(bytes.length() - 24));
+   }
+
+   auto const midnight{ days_from_civil(2023, 10, 19) * nanoseconds_per_day };
+
+   for (auto const& filename : { record_filename, unindexed_filename })
+   {
+       RECORD_READER record_reader;
+
+       if (record_reader.Open(filename) == false or record_reader.NumberOfRecords("RMC") != 3600 or record_reader.NumberOfRecords("GGA") != 3600 or
+           record_reader.NumberOfRecords("VTG") != 1800 or record_reader.NumberOfRecords("DBT") != 1200 or record_reader.NumberOfRecords("GLL") != 0)
+       {
+           printf("Record reader test failed to open %s\n", filename.c_str());
+           continue;
+       }
+
+       std::size_t rmc_index{ 0 };
+       auto all_the_same{ rmc_sentences.size() == 3600 };
+
+       std::ignore = record_reader.Replay<RMC>(INT64_MIN, INT64_MAX, [&](RMC const& rmc)
+       {
+           if (rmc_index >= rmc_sentences.size())
+           {
+               all_the_same = false;
+               return;
+           }
+
+           // Parse the sentence again and compare it where it is, RMC doesn't copy
+
+           record_parser << rmc_sentences[rmc_index++];
+
+           if (record_parser.Parse() == false)
+           {
+               all_the_same = false;
+               return;
+           }
+
+           auto const& parsed{ record_parser.Get<RMC>() };
+
+           if (rmc.UTCTime != parsed.UTCTime or rmc.Date != parsed.Date or rmc.UTCTimeView != parsed.UTCTime or rmc.DateView != parsed.Date or rmc.Timestamp != parsed.Timestamp or rmc.Time != parsed.Time or
+               rmc.IsDataValid != parsed.IsDataValid or rmc.SpeedOverGroundKnots != parsed.SpeedOverGroundKnots or
+               rmc.Position.Latitude.GetSignedMicrodegrees() != parsed.Position.Latitude.GetSignedMicrodegrees() or
+               rmc.Position.Longitude.GetSignedMicrodegrees() != parsed.Position.Longitude.GetSignedMicrodegrees() or
+               rmc.MagneticVariationDirection != parsed.MagneticVariationDirection)
+           {
+               all_the_same = false;
+           }
+       });
+
+       std::vector<int64_t> gga_timestamps;
+
+       auto const number_of_ggas{ record_reader.Replay<GGA>(midnight - 10 * nanoseconds_per_second, midnight + 90 * nanoseconds_per_second, [&](GGA const& gga)
+       {
+           gga_timestamps.push_back(gga.Timestamp);
+       }) };
+
+       auto const number_of_depths{ record_reader.Replay<DBT>(midnight, midnight + 300 * nanoseconds_per_second, [](DBT const&) {}) };
+
+       if (all_the_same == false or rmc_index != 3600 or number_of_ggas != 100 or gga_timestamps.front() != parsed_gga_timestamps[1790] or
+           gga_timestamps.back() != midnight + 89 * nanoseconds_per_second + 89 * nanoseconds_per_second / 100 or number_of_depths != 100)
+       {
+           printf("Record replay test failed with %s\n", filename.c_str());
+       }
+   }
+
+   std::remove(record_filename.c_str());
+   std::remove(unindexed_filename.c_str());
+
+   // Anything written to a sentence throws away the fields it had, even when the length is the same
+   {
+       SENTENCE sentence;
+
+       sentence = STRING_VIEW("$GPHDT,274.07,T*03\r\n");
+       auto const first_heading{ sentence.Field(1) == "274.07" and sentence.IsChecksumBad(2) == NMEA0183_BOOLEAN::False };
+
+       sentence = STRING_VIEW("$GPHDT,123.45,T*04\r\n");
+       auto const second_heading{ sentence.Field(1) == "123.45" and sentence.IsChecksumBad(2) == NMEA0183_BOOLEAN::False };
+
+       sentence = STRING_VIEW("$GPHDT");
+       sentence += STRING_VIEW("274.07");
+       auto const before_finish{ sentence.GetNumberOfDataFields() };
+       sentence += STRING_VIEW("T");
+       sentence.Finish();
+
+       if (first_heading == false or second_heading == false or before_finish != 1 or sentence.GetNumberOfDataFields() != 2 or
+           sentence.Field(2) != "T" or sentence.Checksum() != "03")
+       {
+           printf("Reused sentence test failed\n");
+       }
+   }
+
+   // Borrowed sentences are parsed where they are, the views point into the caller's buffer
+
+   char receive_buffer[] = "$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n$GPRTE,2,1,c,0,W3IWI,DRIVWY,32CEDR*0D\r\n$IIXDR,C,19.5,C,AIRTEMP,P,1.013,B,BARO*2A\r\n";
+   std::string_view const received(receive_buffer);
+   auto const inside_buffer{ [&received](std::string_view field) { return(field.data() >= received.data() and field.data() + field.length() <= received.data() + received.length()); } };
+
+   auto const rmc_end{ received.find('\n') + 1 };
+   auto const rte_end{ received.find('\n', rmc_end) + 1 };
+
+   NMEA0183 borrowing_parser;
+
+   borrowing_parser.Rmc.CopyStrings = false;
+   borrowing_parser.Rte.CopyStrings = false;
+   borrowing_parser.BorrowSentence(received.substr(0, rmc_end));
+
+   if (borrowing_parser.Parse() == false or borrowing_parser.Rmc.UTCTimeView != "225446" or inside_buffer(borrowing_parser.Rmc.UTCTimeView) == false or
+       borrowing_parser.Rmc.DateView != "191194" or inside_buffer(borrowing_parser.Rmc.DateView) == false or
+       borrowing_parser.Rmc.UTCTime.empty() == false or borrowing_parser.Rmc.Date.empty() == false or
+       borrowing_parser.Rmc.Position.Latitude.GetSignedMicrodegrees() != 49274167)
+   {
+       printf("Borrowed RMC test failed with \"%s\"\n", borrowing_parser.GetErrorMessage().c_str());
+   }
+
+   borrowing_parser.BorrowSentence(received.substr(rmc_end, rte_end - rmc_end));
+
+   if (borrowing_parser.Parse() == false or borrowing_parser.Rte.RouteNameView != "0" or inside_buffer(borrowing_parser.Rte.RouteNameView) == false or
+       borrowing_parser.Rte.WaypointViews.empty() == true or borrowing_parser.Rte.WaypointViews[0] != "W3IWI" or
+       inside_buffer(borrowing_parser.Rte.WaypointViews[0]) == false or borrowing_parser.Rte.Waypoints.empty() == false)
+   {
+       printf("Borrowed RTE test failed with \"%s\"\n", borrowing_parser.GetErrorMessage().c_str());
+   }
+
+   borrowing_parser.BorrowSentence(received.substr(rte_end));
+
+   if (borrowing_parser.Parse() == false or borrowing_parser.Xdr.Transducers.size() != 2 or borrowing_parser.Xdr.Transducers[0].TransducerName != "AIRTEMP" or
+       borrowing_parser.Xdr.Transducers[1].TransducerNameView != "BARO" or inside_buffer(borrowing_parser.Xdr.Transducers[1].TransducerNameView) == false)
+   {
+       printf("Borrowed XDR test failed with \"%s\"\n", borrowing_parser.GetErrorMessage().c_str());
+   }
+
+   SENTENCE borrowed_sentence;
+   RMC borrowed_rmc;
+
+   borrowed_sentence.Borrow(received.substr(0, rmc_end));
+
+   if (borrowed_sentence.IsBorrowed() == false or borrowed_rmc.Parse(borrowed_sentence) == false or borrowed_rmc.UTCTime != "225446" or
+       inside_buffer(borrowed_sentence.Field(3)) == false)
+   {
+       printf("Borrowed SENTENCE test failed\n");
+   }
+
+   // Writing to a borrowed sentence takes a copy, the caller's buffer is never touched
+
+   borrowed_sentence += STRING_VIEW("X");
+
+   if (borrowed_sentence.IsBorrowed() == true or std::string_view(receive_buffer, rmc_end) != received.substr(0, rmc_end) or
+       borrowed_sentence.Field(1) != "225446" or inside_buffer(borrowed_sentence.Field(1)) == true)
+   {
+       printf("Borrowed sentence copy on write test failed\n");
+   }
+
+   std::string const tagged_receive_buffer(STRING_VIEW("\\s:GPS1,c:1697500000*45\\$GPGGA,235959,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4B\r\n"));
+
+   borrowing_parser.BorrowSentence(tagged_receive_buffer);
+
+   if (borrowing_parser.Parse() == false or borrowing_parser.GetTagBlock().Source != "GPS1" or borrowing_parser.Gga.Time != 1697500799)
+   {
+       printf("Borrowed tag block test failed with \"%s\"\n", borrowing_parser.GetErrorMessage().c_str());
+   }
+
+#if ! defined( _WIN32 )
+
+   // Several feeds at once, pipes and a pseudo terminal stand in for serial ports
+
+   {
+      using HEADING_INGEST = NMEA0183_INGEST<RMC, HDT>;
+
+      HEADING_INGEST ingest;
+      std::array<int, 4> write_ends{ -1, -1, -1, -1 };
+      std::array<int, 4> read_ends{ -1, -1, -1, -1 };
+
+      for ( std::size_t pipe_index = 0; pipe_index < 3; pipe_index++ )
+      {
+          int pipe_ends[ 2 ]{ -1, -1 };
+
+          if (::pipe(pipe_ends) != 0)
+          {
+              printf("Ingest test failed to make a pipe\n");
+          }
+
+          read_ends[pipe_index] = pipe_ends[0];
+          write_ends[pipe_index] = pipe_ends[1];
+      }
+
+      read_ends[3] = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+      if (read_ends[3] < 0 or ::grantpt(read_ends[3]) != 0 or ::unlockpt(read_ends[3]) != 0 or (write_ends[3] = ::open(::ptsname(read_ends[3]), O_RDWR | O_NOCTTY)) < 0)
+      {
+          printf("Ingest test failed to open a pseudo terminal\n");
+      }
+      else
+      {
+          termios raw_mode;
+
+          ::tcgetattr(write_ends[3], &raw_mode);
+          ::cfmakeraw(&raw_mode);
+          ::tcsetattr(write_ends[3], TCSANOW, &raw_mode);
+      }
+
+      for (std::size_t source_index = 0; source_index < read_ends.size(); source_index++)
+      {
+          std::ignore = ingest.AddFileDescriptor(source_index < 3 ? "Pipe" : "Pseudo terminal", read_ends[source_index]);
+      }
+
+      struct INGESTED
+      {
+          std::size_t Source;
+          int64_t ReceivedAt;
+          NMEA0183_ERROR ErrorCode;
+          double DegreesTrue;
+      };
+
+      std::vector<INGESTED> ingested;
+
+      ingest.NumberOfWorkers = 2;
+
+      std::ignore = ingest.Start([&ingested](HEADING_INGEST::RESULT const& result)
+      {
+          auto const hdt{ result.Get<HDT>() };
+          ingested.push_back({ result.Source, result.Sentence.ReceivedAt, result.ErrorCode, hdt == nullptr ? -1.0 : hdt->DegreesTrue });
+      });
+
+      std::vector<std::thread> feeds;
+
+      for (std::size_t source_index = 0; source_index < write_ends.size(); source_index++)
+      {
+          feeds.emplace_back([source_index, &write_ends]()
+          {
+              HDT hdt;
+              SENTENCE sentence;
+
+              for (int sentence_index = 0; sentence_index < 100; sentence_index++)
+              {
+                  hdt.DegreesTrue = static_cast<double>(source_index * 100 + sentence_index);
+                  hdt.Write(sentence);
+
+                  std::string_view text{ sentence };
+
+                  if (sentence_index == 50 and source_index == 0)
+                  {
+                      std::ignore = ::write(write_ends[source_index], "$GPHDT,1.0,T*00\r\n", 17);
+                  }
+
+                  std::ignore = ::write(write_ends[source_index], text.data(), text.length());
+                  std::this_thread::sleep_for(std::chrono::microseconds(200));
+              }
+
+              ::close(write_ends[source_index]);
+          });
+      }
+
+      for (auto& feed : feeds)
+      {
+          feed.join();
+      }
+
+      ingest.Wait();
+
+      bool in_order{ ingested.size() == 401 };
+      std::array<double, 4> last_heading{ -1.0, -1.0, -1.0, -1.0 };
+      std::size_t number_of_bad_checksums{ 0 };
+
+      for (std::size_t index = 0; index < ingested.size(); index++)
+      {
+          auto const& item{ ingested[index] };
+
+          if (item.ErrorCode == NMEA0183_ERROR::InvalidChecksum and item.Source == 0 and item.DegreesTrue < 0.0)
+          {
+              number_of_bad_checksums++;
+              continue;
+          }
+
+          if (item.ErrorCode != NMEA0183_ERROR::NoError or item.Source >= last_heading.size() or item.DegreesTrue <= last_heading[item.Source] or
+              (index > 0 and item.ReceivedAt < ingested[index - 1].ReceivedAt))
+          {
+              in_order = false;
+              break;
+          }
+
+          last_heading[item.Source] = item.DegreesTrue;
+      }
+
+      auto const pipe_counters{ ingest.GetCounters(0) };
+      auto const terminal_counters{ ingest.GetCounters(3) };
+
+      if (in_order == false or number_of_bad_checksums != 1 or last_heading[3] != 399.0 or pipe_counters.NumberOfSentences != 101 or
+          pipe_counters.NumberOfSentencesParsed != 100 or pipe_counters.NumberOfSentencesNotParsed != 1 or pipe_counters.NumberOfDroppedSentences != 0 or
+          terminal_counters.NumberOfSentencesParsed != 100 or ingest.GetSourceName(3) != "Pseudo terminal")
+      {
+          printf("Ingest test failed, %zu sentences, %zu bad checksums, last heading from the pseudo terminal %.1f\n", ingested.size(), number_of_bad_checksums, last_heading[3]);
+      }
+
+      for (auto const read_end : read_ends)
+      {
+          ::close(read_end);
+      }
+   }
+
+   // A handler that can't keep up, with no waiting allowed sentences are dropped and counted
+
+   {
+      NMEA0183_INGEST<HDT> ingest;
+      std::string burst;
+
+      for (int sentence_index = 0; sentence_index < 100; sentence_index++)
+      {
+          burst.append(STRING_VIEW("$GPHDT,274.07,T*03\r\n"));
+      }
+
+      bool has_been_read{ false };
+
+      ingest.QueueSize = 4;
+      ingest.MaximumQueueWait = std::chrono::milliseconds(0);
+
+      std::ignore = ingest.AddSource("Burst", [&burst, &has_been_read](char * buffer, std::size_t size) -> std::ptrdiff_t
+      {
+          if (has_been_read == true or size < burst.length())
+          {
+              return(-1);
+          }
+
+          has_been_read = true;
+          ::memcpy(buffer, burst.data(), burst.length());
+          return(static_cast<std::ptrdiff_t>(burst.length()));
+      });
+
+      std::size_t number_delivered{ 0 };
+
+      std::ignore = ingest.Start([&number_delivered](NMEA0183_INGEST<HDT>::RESULT const&)
+      {
+          number_delivered++;
+          std::this_thread::sleep_for(std::chrono::microseconds(500));
+      });
+
+      ingest.Wait();
+
+      auto const counters{ ingest.GetCounters(0) };
+
+      if (counters.NumberOfDroppedSentences == 0 or counters.NumberOfSentences != number_delivered or
+          counters.NumberOfSentences + counters.NumberOfDroppedSentences != 100 or counters.NumberOfBytes != burst.length())
+      {
+          printf("Ingest backpressure test failed, %zu delivered\n", number_delivered);
+      }
+   }
+
+   // The text views of a response handed to the handler point into the result, not the queue the reader reuses
+
+   {
+      NMEA0183_INGEST<RMC> ingest;
+      std::string burst;
+
+      for (int sentence_index = 0; sentence_index < 50; sentence_index++)
+      {
+          burst.append(STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n"));
+      }
+
+      bool has_been_read{ false };
+
+      std::ignore = ingest.AddSource("RMC", [&burst, &has_been_read](char * buffer, std::size_t size) -> std::ptrdiff_t
+      {
+          if (has_been_read == true or size < burst.length())
+          {
+              return(-1);
+          }
+
+          has_been_read = true;
+          ::memcpy(buffer, burst.data(), burst.length());
+          return(static_cast<std::ptrdiff_t>(burst.length()));
+      });
+
+      std::size_t number_inside{ 0 };
+
+      std::ignore = ingest.Start([&number_inside](NMEA0183_INGEST<RMC>::RESULT const& result)
+      {
+          auto const rmc{ result.Get<RMC>() };
+
+          if (rmc != nullptr and rmc->UTCTimeView == "225446" and rmc->UTCTimeView.data() >= result.Sentence.Text and
+              rmc->DateView.data() + rmc->DateView.length() <= result.Sentence.Text + result.Sentence.Length)
+          {
+              number_inside++;
+          }
+      });
+
+      ingest.Wait();
+
+      if (number_inside != 50)
+      {
+          printf("Ingest view test failed, %zu of 50 inside the result\n", number_inside);
+      }
+   }
+
+#endif // _WIN32
+
+   // Manufacturers and talker IDs come out of read only tables, every one of them can be found
+
+   std::size_t number_of_manufacturers{ 0 };
+   bool every_manufacturer_found{ true };
+
+   for (auto const& manufacturer : MANUFACTURER_LIST())
+   {
+       number_of_manufacturers++;
+
+       if (MANUFACTURER_LIST::Find(manufacturer.Mnemonic).data() != manufacturer.CompanyName.data())
+       {
+           every_manufacturer_found = false;
+       }
+   }
+
+   nmea0183 << STRING_VIEW("$PGRMM,NAD27 Canada*2F\r\n");
+
+   if (every_manufacturer_found == false or number_of_manufacturers != 333 or MANUFACTURER_LIST::Find(STRING_VIEW("YAS")) != "Yaesu Electronics" or
+       MANUFACTURER_LIST::Find(STRING_VIEW("ZZZ")).empty() == false or MANUFACTURER_LIST::Find(STRING_VIEW("gr")).empty() == false or
+       nmea0183.Parse() == false or nmea0183.Proprietary.CompanyName != "Garmin Corporation")
+   {
+       printf("Manufacturer table test failed, %zu manufacturers\n", number_of_manufacturers);
+   }
+
+   if (talker_description(STRING_VIEW("GP")) != "Global Positioning System (GPS)" or talker_description(STRING_VIEW("ZV")) != "Timekeeper - Radio Update, WWV or WWVH" or
+       talker_description(STRING_VIEW("AG")) != "Autopilot - General" or talker_description(STRING_VIEW("QQ")).empty() == false or
+       talker_description(STRING_VIEW("G")).empty() == false or expand_talker_id(STRING_VIEW("QQ")) != "Unknown - QQ" or
+       expand_talker_id(STRING_VIEW("HE")) != "Heading - North Seeking Gyro")
+   {
+       printf("Talker ID table test failed\n");
+   }
+
+   // Every scan kernel gives the same answer as looking at one character at
+   // a time, whatever the length and whatever is in the buffer
+   {
+       std::mt19937 random_numbers(0x0183);
+       std::array<char, 320> buffer;
+       char const interesting[] = { ',', '*', CARRIAGE_RETURN, LINE_FEED, '$', '!', 0x00, 'A', '0', static_cast<char>(0x80), static_cast<char>(0xAA), static_cast<char>(0xFF) };
+       int number_of_mismatches = 0;
+
+       for (auto const name : { "scalar", "sse2", "avx2" })
+       {
+           auto const kernel = find_scan_kernel(name);
+
+           if (kernel == nullptr)
+           {
+               continue; // Not on this processor
+           }
+
+           for (int loop_index = 0; loop_index < 2000; loop_index++)
+           {
+               for (auto& character : buffer)
+               {
+                   auto const random_number = random_numbers();
+                   character = (random_number & 1) ? interesting[(random_number >> 1) % sizeof(interesting)] : static_cast<char>(random_number >> 8);
+               }
+
+               auto const offset = random_numbers() % 16; // Unaligned loads too
+               auto const length = random_numbers() % 65;
+
+               CHARACTER_MASKS expected;
+
+               for (std::size_t index = 0; index < length; index++)
+               {
+                   auto const bit = static_cast<uint64_t>(1) << index;
+                   auto const character = buffer[offset + index];
+
+                   expected.Commas |= (character == ',') ? bit : 0;
+                   expected.Stars |= (character == '*') ? bit : 0;
+                   expected.CarriageReturns |= (character == CARRIAGE_RETURN) ? bit : 0;
+                   expected.LineFeeds |= (character == LINE_FEED) ? bit : 0;
+                   expected.Starts |= (character == '$' or character == '!') ? bit : 0;
+                   expected.Nuls |= (character == 0x00) ? bit : 0;
+               }
+
+               CHARACTER_MASKS masks;
+               masks.Commas = 0xFFFF; // Whatever was there before is thrown away
+
+               kernel->classify(buffer.data() + offset, length, masks);
+
+               if (masks.Commas != expected.Commas or masks.Stars != expected.Stars or masks.CarriageReturns != expected.CarriageReturns or
+                   masks.LineFeeds != expected.LineFeeds or masks.Starts != expected.Starts or masks.Nuls != expected.Nuls)
+               {
+                   number_of_mismatches++;
+               }
+
+               auto const checksum_length = random_numbers() % (buffer.size() - offset + 1);
+               uint8_t expected_checksum = 0;
+
+               for (std::size_t index = 0; index < checksum_length; index++)
+               {
+                   expected_checksum ^= static_cast<uint8_t>(buffer[offset + index]);
+               }
+
+               if (kernel->exclusive_or(buffer.data() + offset, checksum_length) != expected_checksum)
+               {
+                   number_of_mismatches++;
+               }
+           }
+
+           if (number_of_mismatches != 0)
+           {
+               printf("Scan kernel test failed, %d mismatches from %s\n", number_of_mismatches, name);
+               number_of_mismatches = 0;
+           }
+       }
+
+       if (find_scan_kernel("scalar") == nullptr or find_scan_kernel("mmx") != nullptr)
+       {
+           printf("Scan kernel lookup test failed\n");
+       }
+   }
+
+   // Every field heard is stamped, only a value that moves counts as a change. Readers never see half an update
+
+   {
+      VESSEL_STATE_TRACKER tracker;
+      NMEA0183 state_parser;
+
+      state_parser << STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n");
+
+      auto const first_update{ state_parser.Parse() == true and tracker.Update(state_parser, 1000) == true };
+
+      state_parser << STRING_VIEW("$GPRMC,225446,A,4916.45,N,12311.12,W,000.5,054.7,191194,020.3,E*68\r\n");
+
+      auto const same_again{ state_parser.Parse() == true and tracker.Update(state_parser, 2000) == true };
+
+      state_parser << STRING_VIEW("$WIMWV,214.8,R,0.1,M,A*2E\r\n");
+
+      auto const wind_update{ state_parser.Parse() == true and tracker.Update(state_parser, 3000) == true };
+
+      // A sounder that only gives feet leaves the depth alone
+
+      state_parser << STRING_VIEW("$SDDBT,36.1,f,11.0,M,6.0,F*04\r\n");
+
+      auto const depth_update{ state_parser.Parse() == true and tracker.Update(state_parser, 4000) == true };
+
+      state_parser << STRING_VIEW("$SDDBT,36.1,f,,M,6.0,F*1A\r\n");
+
+      auto const no_meters{ state_parser.Parse() == true and tracker.Update(state_parser, 5000) == true };
+
+      auto const state{ tracker.Get() };
+
+      if (first_update == false or same_again == true or wind_update == false or depth_update == false or no_meters == true or
+          tracker.GetNumberOfUpdates() != 4 or state.DepthMeters.Value != 11.0 or state.DepthMeters.Timestamp != 4000 or
+          state.Position.Timestamp != 2000 or state.Position.GetTalker() != "GP" or ::fabs(state.Position.Value.Latitude - 49.274167) > 0.000001 or
+          ::fabs(state.Position.Value.Longitude + 123.185333) > 0.000001 or state.SpeedOverGroundKnots.Value != 0.5 or
+          state.ApparentWindAngle.Value != 214.8 or ::fabs(state.ApparentWindSpeedKnots.Value - 0.194384) > 0.000001 or
+          state.ApparentWindSpeedKnots.GetTalker() != "WI" or state.TrueWindAngle.IsSet() == true or state.HeadingDegreesTrue.IsSet() == true)
+      {
+          printf("Vessel state test failed\n");
+      }
+
+      std::atomic<bool> writing{ true };
+      std::atomic<int> number_of_torn_reads{ 0 };
+      std::vector<std::thread> readers;
+
+      for (int reader_index = 0; reader_index < 2; reader_index++)
+      {
+          readers.emplace_back([&tracker, &writing, &number_of_torn_reads]()
+          {
+              while (writing == true)
+              {
+                  auto const heading{ tracker.Get().HeadingDegreesTrue };
+
+                  if (heading.IsSet() == true and static_cast<int64_t>(heading.Value) + 1 != heading.Timestamp)
+                  {
+                      number_of_torn_reads++;
+                  }
+              }
+          });
+      }
+
+      HDT hdt;
+
+      for (int heading_index = 0; heading_index < 100000; heading_index++)
+      {
+          hdt.DegreesTrue = static_cast<double>(heading_index);
+          std::ignore = tracker.Update(hdt, STRING_VIEW("HE"), heading_index + 1);
+      }
+
+      writing = false;
+
+      for (auto& reader : readers)
+      {
+          reader.join();
+      }
+
+      if (number_of_torn_reads != 0 or tracker.Get().HeadingDegreesTrue.Value != 99999.0)
+      {
+          printf("Vessel state snapshot test failed, %d torn reads\n", number_of_torn_reads.load());
+      }
+   }
+
+   // Multi-part sentences are collected in order, anything out of order is a gap
+
+   {
+      NMEA0183 group_parser;
+      std::vector<bool> complete;
+
+      for (auto const sentence : { STRING_VIEW("$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"),
+                                   STRING_VIEW("$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74\r\n"),
+                                   STRING_VIEW("$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D\r\n") })
+      {
+          group_parser << sentence;
+          complete.push_back(group_parser.Parse() == true and group_parser.Gsv.IsComplete == true);
+      }
+
+      if (complete != std::vector<bool>{ false, false, true } or group_parser.Gsv.NumberOfSatellites != 11 or
+          group_parser.Gsv.SatellitesInView[10].SatelliteNumber != 27 or group_parser.Gsv.SatellitesInView[11].SatelliteNumber != 0)
+      {
+          printf("GSV group test failed\n");
+      }
+
+      // Written back out it takes the same three messages
+
+      NMEA0183 written_parser;
+      SENTENCE written;
+      int number_of_written{ 0 };
+
+      if (group_parser.Gsv.WriteMessages(written, [&](SENTENCE const& message)
+          {
+              written_parser << message.Text();
+              number_of_written += (written_parser.Parse() == true) ? 1 : 0;
+          }) == false or number_of_written != 3 or written_parser.Gsv.IsComplete == false or written_parser.Gsv.NumberOfSatellites != 11 or
+          written_parser.Gsv.SatellitesInView[5].SignalToNoiseRatio != 39 or written_parser.Gsv.SatellitesInView[10].AzimuthDegreesTrue != 244)
+      {
+          printf("GSV multiple message write test failed\n");
+      }
+
+      group_parser << STRING_VIEW("$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D\r\n");
+
+      if (group_parser.Parse() == false or group_parser.Gsv.GroupStatus != MESSAGE_GROUP_STATUS::Gap or group_parser.Gsv.IsComplete == true or
+          group_parser.Gsv.SatellitesInView[8].SatelliteNumber != 22 or group_parser.Gsv.SatellitesInView[0].SatelliteNumber != 0)
+      {
+          printf("GSV gap test failed\n");
+      }
+
+      // Coming in part way through a group still gets the data, the group just isn't whole
+
+      NMEA0183 fresh_parser;
+
+      fresh_parser << STRING_VIEW("$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74\r\n");
+
+      auto const fresh_gsv{ fresh_parser.Parse() == true and fresh_parser.Gsv.GroupStatus == MESSAGE_GROUP_STATUS::Gap and fresh_parser.Gsv.SatellitesInView[4].SatelliteNumber == 14 };
+
+      fresh_parser << STRING_VIEW("$GPRTE,2,2,c,0,PBRCPK,PBRTO*44\r\n");
+
+      auto const fresh_rte{ fresh_parser.Parse() == true and fresh_parser.Rte.IsComplete == false and fresh_parser.Rte.Waypoints == std::vector<std::string>{ "PBRCPK", "PBRTO" } };
+
+      fresh_parser << STRING_VIEW("$GPALM,31,17,17,1023,00,4A2C,90,0F61,FD2B,A10D73,4BA2CA,6A1E7E,C0A2B0,1A1,003*01\r\n");
+
+      auto const fresh_alm{ fresh_parser.Parse() == true and fresh_parser.Alm.PRNNumber == 17 and fresh_parser.Alm.IsComplete == false };
+
+      if (fresh_gsv == false or fresh_rte == false or fresh_alm == false)
+      {
+          printf("Part way through a group test failed, %d %d %d\n", fresh_gsv, fresh_rte, fresh_alm);
+      }
+
+      // A route too long for one sentence is split to fit 82 characters and comes back whole
+
+      RTE route;
+
+      route.DataSource  = "GP";
+      route.TypeOfRoute = RTE::ROUTE_TYPE::CompleteRoute;
+      route.RouteName   = "HARBOUR";
+
+      for (int waypoint_number = 1; waypoint_number <= 30; waypoint_number++)
+      {
+          route.Waypoints.push_back("WAYPOINT" + std::to_string(waypoint_number));
+      }
+
+      std::vector<std::string> route_sentences;
+
+      std::ignore = route.WriteMessages(written, [&](SENTENCE const& message) { route_sentences.push_back(std::string(message.Text())); });
+
+      bool route_fits{ route_sentences.size() > 1 and static_cast<int>(route_sentences.size()) == route.GetNumberOfMessagesToWrite() };
+
+      for (std::size_t message_index = 0; message_index < route_sentences.size(); message_index++)
+      {
+          written_parser << route_sentences[message_index];
+
+          route_fits = route_fits and route_sentences[message_index].length() <= 82 and written_parser.Parse() == true and
+                       written_parser.Rte.IsComplete == (message_index + 1 == route_sentences.size());
+      }
+
+      if (route_fits == false or written_parser.Rte.Waypoints != route.Waypoints or written_parser.Rte.RouteName != "HARBOUR" or
+          written_parser.Rte.WaypointViews.empty() == true or written_parser.Rte.WaypointViews.back() != "WAYPOINT30")
+      {
+          printf("RTE multiple message test failed with %d sentences\n", static_cast<int>(route_sentences.size()));
+      }
+
+      written_parser << route_sentences[0];
+      std::ignore = written_parser.Parse();
+      written_parser << route_sentences[2];
+
+      if (written_parser.Parse() == false or written_parser.Rte.GroupStatus != MESSAGE_GROUP_STATUS::Gap or written_parser.Rte.Waypoints.empty() == true or
+          written_parser.Rte.Waypoints.front() != "WAYPOINT11")
+      {
+          printf("RTE gap test failed\n");
+      }
+   }
+
+   // Every constellation's satellites go out together, one whole epoch at a time
+
+   {
+      GNSS_EPOCH_TRACKER tracker;
+      NMEA0183 epoch_parser;
+      GSV gsv;
+      GSA gsa;
+      SENTENCE written;
+      int64_t now{ 1000000000 };
+      std::vector<std::string> gps_sentences;
+      std::string glonass_sentence;
+      std::string gps_used_sentence;
+
+      gsv.DataSource = "GP";
+      gsv.NumberOfSatellites = 5;
+
+      for (int satellite_index = 0; satellite_index < 5; satellite_index++)
+      {
+          gsv.SatellitesInView[satellite_index].SatelliteNumber = satellite_index + 1;
+          gsv.SatellitesInView[satellite_index].ElevationDegrees = 10 * satellite_index;
+          gsv.SatellitesInView[satellite_index].SignalToNoiseRatio = 40;
+      }
+
+      std::ignore = gsv.WriteMessages(written, [&](SENTENCE const& message) { gps_sentences.push_back(std::string(message.Text())); });
+
+      gsv.DataSource = "GL";
+      gsv.NumberOfSatellites = 3;
+
+      for (int satellite_index = 0; satellite_index < 3; satellite_index++)
+      {
+          gsv.SatellitesInView[satellite_index].SatelliteNumber = 65 + satellite_index;
+      }
+
+      std::ignore = gsv.WriteMessages(written, [&](SENTENCE const& message) { glonass_sentence = message.Text(); });
+
+      gsa.DataSource = "GP";
+      gsa.FixMode = GSA::FIX_MODE::ThreeDimensional;
+      gsa.SatelliteNumber[0] = 1;
+      gsa.SatelliteNumber[1] = 2;
+      gsa.HDOP = 1.5;
+      gsa.Write(written);
+      gps_used_sentence = written.Text();
+
+      // NMEA 4.10 says which system a GN GSA is for
+
+      gsa.DataSource = "GN";
+      gsa.SatelliteNumber[0] = 66;
+      gsa.SatelliteNumber[1] = 0;
+      gsa.SystemID = 2;
+      gsa.Write(written);
+      epoch_parser << written.Text();
+
+      if (epoch_parser.Parse() == false or epoch_parser.Gsa.SystemID != 2 or tracker.Update(epoch_parser, now) == true)
+      {
+          printf("GSA system ID test failed\n");
+      }
+
+      auto const feed{ [&](std::string const& sentence)
+      {
+          now += 10000000;
+          epoch_parser << sentence;
+          return(epoch_parser.Parse() == true and tracker.Update(epoch_parser, now) == true);
+      } };
+
+      // The first epoch only goes out when GP starts over, after that when everyone has finished
+
+      std::vector<bool> published;
+      int64_t first_epoch_started{ 0 };
+
+      for (int epoch_index = 0; epoch_index < 2; epoch_index++)
+      {
+          published.push_back(feed(gps_used_sentence));
+          published.push_back(feed(gps_sentences[0]));
+          first_epoch_started = (epoch_index == 0) ? now : first_epoch_started;
+          published.push_back(feed(gps_sentences[1]));
+          published.push_back(feed(glonass_sentence));
+      }
+
+      auto const epoch{ tracker.Get() };
+
+      if (published != std::vector<bool>{ false, false, false, false, false, true, false, true } or epoch.EpochNumber != 2 or
+          epoch.NumberOfSatellites != 8 or epoch.NumberOfSatellitesUsed != 3 or epoch.Satellites[6].IsUsed == false or epoch.HDOP != 1.5 or
+          epoch.Satellites[0].GetTalker() != "GP" or epoch.Satellites[0].IsUsed == false or epoch.Satellites[4].ElevationDegrees != 40 or
+          epoch.Satellites[5].GetTalker() != "GL" or epoch.Satellites[5].SatelliteNumber != 65 or epoch.Satellites[5].IsUsed == true or
+          epoch.Timestamp <= first_epoch_started or tracker.GetCounters().Completed != 4)
+      {
+          printf("GNSS epoch test failed\n");
+      }
+
+      // GP loses its second message, that epoch goes out with only GLONASS in it
+
+      std::ignore = feed(gps_sentences[0]);
+      std::ignore = feed(glonass_sentence);
+      std::ignore = feed(gps_sentences[0]);
+      published.assign(1, feed(glonass_sentence));
+
+      if (published[0] == false or tracker.Get().NumberOfSatellites != 3 or tracker.Get().Satellites[0].GetTalker() != "GL" or
+          tracker.Get().Satellites[3].SatelliteNumber != 0 or tracker.GetCounters().Gaps != 1)
+      {
+          printf("GNSS epoch gap test failed\n");
+      }
+
+      // A group that takes too long is thrown away, not finished. GP's
+      // last group never finished either, that's another gap
+
+      std::ignore = feed(gps_sentences[0]);
+      now += 3000000000;
+      std::ignore = feed(gps_sentences[1]);
+
+      if (tracker.GetCounters().Timeouts != 1 or tracker.GetCounters().Gaps != 2)
+      {
+          printf("GNSS epoch timeout test failed\n");
+      }
+
+      // Readers on other threads never see half of one epoch and half of another
+
+      std::atomic<bool> writing{ true };
+      std::atomic<int> number_of_torn_reads{ 0 };
+      std::vector<std::thread> readers;
+
+      tracker.Empty();
+
+      for (int reader_index = 0; reader_index < 2; reader_index++)
+      {
+          readers.emplace_back([&tracker, &writing, &number_of_torn_reads]()
+          {
+              while (writing == true)
+              {
+                  auto const snapshot{ tracker.Get() };
+
+                  for (int satellite_index = 0; satellite_index < snapshot.NumberOfSatellites; satellite_index++)
+                  {
+                      if (snapshot.NumberOfSatellites != 4 or snapshot.Satellites[satellite_index].AzimuthDegreesTrue != snapshot.Satellites[0].AzimuthDegreesTrue)
+                      {
+                          number_of_torn_reads++;
+                      }
+                  }
+              }
+          });
+      }
+
+      GSV single;
+
+      single.NumberOfMessages = 1;
+      single.MessageNumber = 1;
+      single.NumberOfSatellites = 4;
+
+      for (int update_index = 0; update_index < 20000; update_index++)
+      {
+          for (int satellite_index = 0; satellite_index < 4; satellite_index++)
+          {
+              single.SatellitesInView[satellite_index].SatelliteNumber = satellite_index + 1;
+              single.SatellitesInView[satellite_index].AzimuthDegreesTrue = update_index % 360;
+          }
+
+          std::ignore = tracker.Update(single, STRING_VIEW("GP"), update_index + 1);
+      }
+
+      writing = false;
+
+      for (auto& reader : readers)
+      {
+          reader.join();
+      }
+
+      if (number_of_torn_reads != 0 or tracker.Get().Satellites[0].AzimuthDegreesTrue != 19999 % 360)
+      {
+          printf("GNSS epoch snapshot test failed, %d torn reads\n", number_of_torn_reads.load());
+      }
+   }
+
+   // Every thread gets its own parser, nothing else is shared. Build with
+   // -fsanitize=thread to have ThreadSanitizer check that this holds
+
+   // The first time through dateless times are put on today, after that on
+   // the day of the last fix in the list
+
+   std::array<std::vector<std::string>, 2> expected_plain_english;
+   NMEA0183 single_thread_parser;
+
+   for (auto& expected : expected_plain_english)
+   {
+       for (auto const& item : test_sentences)
+       {
+           single_thread_parser << item.sentence;
+           expected.push_back(single_thread_parser.Parse() == true ? single_thread_parser.PlainText : std::string());
+       }
+   }
+
+   std::atomic<int> number_of_plain_english_failures{ 0 };
+   std::vector<std::thread> threads;
+
+   for (int thread_index = 0; thread_index < 8; thread_index++)
+   {
+       threads.emplace_back([&test_sentences, &expected_plain_english, &number_of_plain_english_failures]()
+       {
+           NMEA0183 parser;
+
+           for (int loop_index = 0; loop_index < 100; loop_index++)
+           {
+               for (std::size_t test_index = 0; test_index < test_sentences.size(); test_index++)
+               {
+                   parser << test_sentences[test_index].sentence;
+
+                   if (parser.Parse() == true and parser.PlainText.compare(expected_plain_english[std::min(loop_index, 1)][test_index]) != 0)
+                   {
+                       number_of_plain_english_failures++;
+                   }
+               }
+           }
+       });
+   }
+
+   for (auto& thread : threads)
+   {
+       thread.join();
+   }
+
+   if (number_of_plain_english_failures != 0)
+   {
+       printf("Thread test failed, %d plain English mismatches\n", number_of_plain_english_failures.load());
+   }
+
    return( EXIT_SUCCESS );
 }
@@ -42,12 +42,26 @@ SOFTWARE.
 #include <string>
 #include <string_view>
 #include <vector>
+#include <array>
 #include <algorithm>
 #include <charconv>
 #include <math.h>
 #include <time.h>
 #include <inttypes.h>
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <tuple>
+#include <cstdio>
+#include <string.h>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <variant>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
 
 #define STRING_VIEW(_x)  std::string_view(  _x, std::size(_x) - 1)
 
@@ -146,6 +160,26 @@ enum class FAA_MODE
     Manual = 'M'
 };
 
+/*
+** Why Parse() returned false. The text for these is only built when
+** FillTextOnParse is set or somebody asks for it with GetErrorMessage().
+*/
+
+enum class NMEA0183_ERROR
+{
+    NoError = 0,
+    NotASentence,            // Doesn't begin with $ or ! and end with CR LF
+    InvalidTagBlockChecksum,
+    UnknownSentence,
+    InvalidChecksum,
+    MissingChecksum,
+    InvalidFragment,
+    FragmentOutOfSequence,
+    InvalidPayload,
+    NotSubscribed,           // Something is subscribed but not to this one, see SUBSCRIB.HPP
+    Other                    // RESPONSE::SetErrorMessage() was given text of its own
+};
+
 /*
 ** Misc Function Prototypes
 */
@@ -159,7 +193,222 @@ inline uint32_t HexValue(std::string_view hex_string) noexcept
     return(return_value);
 }
 
+/*
+** Sentence mnemonics are packed five bits per letter into a 15 bit key.
+** Anything that isn't one to three upper case letters gets a key of zero.
+** mnemonic_slot() is a multiplicative hash that puts every mnemonic this
+** library understands into its own slot of a 256 entry table.
+*/
+
+inline constexpr uint16_t mnemonic_key(std::string_view mnemonic) noexcept
+{
+    if (mnemonic.empty() or mnemonic.length() > 3)
+    {
+        return(0);
+    }
+
+    uint16_t key{ 0 };
+
+    for (auto const character : mnemonic)
+    {
+        if (character < 'A' or character > 'Z')
+        {
+            return(0);
+        }
+
+        key = static_cast<uint16_t>((key << 5) bitor (character - '@'));
+    }
+
+    return(key);
+}
+
+inline constexpr std::size_t mnemonic_slot(uint16_t const key) noexcept
+{
+    return((static_cast<uint32_t>(key) * UINT32_C(0xF6437695)) >> 24);
+}
+
+/*
+** The manufacturer and talker ID tables are constexpr arrays of things with
+** a Key, sorted by it. These check the order at compile time and look one up.
+*/
+
+template <typename T, std::size_t N>
+inline constexpr bool is_sorted_by_key(std::array<T, N> const& table) noexcept
+{
+    for (std::size_t index = 1; index < N; index++)
+    {
+        if (table[index - 1].Key >= table[index].Key)
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+template <typename T, std::size_t N>
+inline constexpr T const * find_by_key(std::array<T, N> const& table, uint16_t const key) noexcept
+{
+    if (key == 0)
+    {
+        return(nullptr);
+    }
+
+    std::size_t low{ 0 };
+    std::size_t high{ N };
+
+    while (low < high)
+    {
+        auto const middle{ low + (high - low) / 2 };
+
+        if (table[middle].Key < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return((low < N and table[low].Key == key) ? &table[low] : nullptr);
+}
+
+/*
+** classify_characters() looks at up to 64 characters and sets bit n of a
+** mask when character n is one of the ones NMEA cares about. It and
+** xor_characters() use SSE2 or AVX2 when the processor has them, set the
+** NMEA0183_SCAN environment variable to scalar, sse2 or avx2 to pick one.
+*/
+
+struct CHARACTER_MASKS
+{
+    uint64_t Commas{ 0 };
+    uint64_t Stars{ 0 };
+    uint64_t CarriageReturns{ 0 };
+    uint64_t LineFeeds{ 0 };
+    uint64_t Starts{ 0 }; // $ or !
+    uint64_t Nuls{ 0 };
+};
+
+void classify_characters( char const * characters, std::size_t number_of_characters, CHARACTER_MASKS& masks ) noexcept;
+uint8_t xor_characters( char const * characters, std::size_t number_of_characters ) noexcept;
+char const * scan_kernel_name( void ) noexcept;
+
+inline int lowest_set_bit(uint64_t const mask) noexcept
+{
+#if defined( _MSC_VER )
+    unsigned long index{ 0 };
+    _BitScanForward64(&index, mask);
+    return(static_cast<int>(index));
+#else
+    return(__builtin_ctzll(mask));
+#endif
+}
+
+/*
+** parse_angle() reads a ddmm.mmmm latitude or dddmm.mmmm longitude field
+** without going through a double, see FIXED_ANGLE. angles_to_degrees() and
+** angles_to_microdegrees() convert whole columns of them, negative when the
+** matching hemisphere field (if any) is S or W. Fields that aren't plain
+** unsigned numbers come out as NaN or INT32_MIN. They return how many of
+** the fields were good.
+*/
+
+struct FIXED_ANGLE;
+
+bool parse_angle( std::string_view field, FIXED_ANGLE& angle ) noexcept;
+std::size_t angles_to_degrees( std::string_view const * angles, std::string_view const * hemispheres, std::size_t number_of_angles, double * degrees ) noexcept;
+std::size_t angles_to_microdegrees( std::string_view const * angles, std::string_view const * hemispheres, std::size_t number_of_angles, int32_t * microdegrees ) noexcept;
+
+/*
+** gmtime() and ctime() hand back pointers to buffers shared by every thread
+** in the process, use these instead
+*/
+
+inline struct tm universal_time(time_t const time_value) noexcept
+{
+    struct tm broken_down_time{};
+
+#if defined( _WIN32 )
+    ::gmtime_s(&broken_down_time, &time_value);
+#else
+    ::gmtime_r(&time_value, &broken_down_time);
+#endif
+
+    return(broken_down_time);
+}
+
+/*
+** The time kernel turns NMEA dates and times into nanoseconds since 1970
+** with integer arithmetic, no time(), gmtime() or timegm(). Dates are in
+** the proleptic Gregorian calendar (Howard Hinnant's days_from_civil()),
+** two digit years before 80 are this century.
+*/
+
+constexpr int64_t nanoseconds_per_second{ INT64_C(1000000000) };
+constexpr int64_t nanoseconds_per_day{ INT64_C(86400) * nanoseconds_per_second };
+
+inline constexpr int64_t floor_divide(int64_t const numerator, int64_t const denominator) noexcept
+{
+    return((numerator / denominator) - (((numerator % denominator) not_eq 0 and ((numerator < 0) not_eq (denominator < 0))) ? 1 : 0));
+}
+
+inline constexpr int64_t days_from_civil(int64_t year, int64_t const month, int64_t const day) noexcept
+{
+    // month is 1 to 12, the year starts in March so the leap day is at the end
+
+    year -= (month <= 2) ? 1 : 0;
+
+    auto const era{ floor_divide(year, 400) };
+    auto const year_of_era{ year - (era * 400) };
+    auto const day_of_year{ ((153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5) + day - 1 };
+    auto const day_of_era{ (year_of_era * 365) + (year_of_era / 4) - (year_of_era / 100) + day_of_year };
+
+    return((era * 146097) + day_of_era - 719468);
+}
+
+inline constexpr void civil_from_days(int64_t days, int64_t& year, int64_t& month, int64_t& day) noexcept
+{
+    // The other way round, month comes back as 1 to 12
+
+    days += 719468;
+
+    auto const era{ floor_divide(days, 146097) };
+    auto const day_of_era{ days - (era * 146097) };
+    auto const year_of_era{ (day_of_era - (day_of_era / 1460) + (day_of_era / 36524) - (day_of_era / 146096)) / 365 };
+    auto const day_of_year{ day_of_era - ((365 * year_of_era) + (year_of_era / 4) - (year_of_era / 100)) };
+    auto const month_from_march{ ((5 * day_of_year) + 2) / 153 };
+
+    day = day_of_year - (((153 * month_from_march) + 2) / 5) + 1;
+    month = month_from_march + ((month_from_march < 10) ? 3 : -9);
+    year = year_of_era + (era * 400) + ((month <= 2) ? 1 : 0);
+}
+
+inline constexpr time_t seconds_from_nanoseconds(int64_t const nanoseconds) noexcept
+{
+    return(static_cast<time_t>(floor_divide(nanoseconds, nanoseconds_per_second)));
+}
+
+bool parse_date( std::string_view ddmmyy, int64_t& days_since_1970 ) noexcept;
+bool parse_time_of_day( std::string_view hhmmss, int64_t& nanoseconds_since_midnight ) noexcept;
+
+/*
+** format_fixed() prints value the way sprintf("%0<width>.<precision>f")
+** does, but with std::to_chars and without the locale. It returns the
+** number of characters written, zero if they won't fit.
+*/
+
+inline constexpr char hex_digit(uint32_t const nybble) noexcept
+{
+    return("0123456789ABCDEF"[nybble bitand 0x0F]);
+}
+
+std::size_t format_fixed( char * buffer, std::size_t buffer_size, double const value, int const precision, int const width = 0 ) noexcept;
+std::string_view error_text( NMEA0183_ERROR const error ) noexcept;
+std::string format_time( time_t const time_value ) noexcept;
 std::string expand_talker_id( std::string_view talker ) noexcept;
+std::string_view talker_description( std::string_view talker ) noexcept; // Empty when unknown, expand_talker_id() says "Unknown - XX"
 std::string Hex( uint32_t const value ) noexcept;
 std::string talker_id( std::string_view sentence ) noexcept;
 time_t ctime( int const year, int const month, int const day, int const hour, int const minute, int const second) noexcept;
@@ -38,8 +38,16 @@ SOFTWARE.
 ** General Purpose Classes
 */
 
+#include "TAGBLOCK.HPP"
 #include "SENTENCE.HPP"
+#include "FRAMER.HPP"
 #include "RESPONSE.HPP"
+#include "ENCODER.HPP"
+#include "STATS.HPP"
+#include "SUBSCRIB.HPP"
+#include "DUPLICAT.HPP"
+#include "STATUS.HPP"
+#include "GROUP.HPP"
 #include "LATLONG.HPP"
 #include "LORANTD.HPP"
 #include "MANUFACT.HPP"
@@ -51,6 +59,7 @@ SOFTWARE.
 #include "SATDAT.HPP"
 #include "FREQMODE.HPP"
 #include "WAYPTLOC.HPP" // Sentence Not Recommended For New Designs
+#include "AIS.HPP"
 
 /*
 ** Response Classes
@@ -115,6 +124,8 @@ SOFTWARE.
 #include "TRF.HPP"
 #include "TTM.HPP"
 #include "VBW.HPP"
+#include "VDM.HPP"
+#include "VDO.HPP"
 #include "VDR.HPP"
 #include "VHW.HPP"
 #include "VLW.HPP"
@@ -141,19 +152,27 @@ SOFTWARE.
 #include "ZWP.HPP" // Sentence Not Recommended For New Designs
 #include "ZZU.HPP" // Sentence Not Recommended For New Designs
 
-class NMEA0183
+class NMEA0183 : public PARSE_STATUS
 {
    private:
 
       SENTENCE m_Sentence;
+      RESPONSE const * m_LastResponse{ nullptr };
+      char m_TalkerID[ 2 ]{ 0, 0 };
+      SUBSCRIPTIONS m_Subscriptions;
 
       void m_Initialize( void ) noexcept;
+      bool m_Parse( void ) noexcept;
 
    protected:
 
       std::vector<RESPONSE *> m_ResponseTable;
+      std::array<RESPONSE *, 256> m_DispatchTable{};
+      std::size_t m_NumberOfDispatchableResponses{ 0 };
 
       void m_SetContainerPointers( void ) noexcept;
+      void m_FillDispatchTable( void ) noexcept;
+      RESPONSE * m_FindResponse( std::string_view mnemonic ) const noexcept;
 
    public:
 
@@ -231,6 +250,8 @@ class NMEA0183
       TRF Trf;
       TTM Ttm;
       VBW Vbw;
+      VDM Vdm;
+      VDO Vdo;
       VDR Vdr;
       VHW Vhw;
       VLW Vlw;
@@ -257,7 +278,6 @@ class NMEA0183
       ZWP Zwp; // Sentence Not Recommended For New Designs
       ZZU Zzu; // Sentence Not Recommended For New Designs
 
-      std::string ErrorMessage; // Filled when Parse returns FALSE
       std::string LastSentenceIDParsed; // ID of the lst sentence successfully parsed
       std::string LastSentenceIDReceived; // ID of the last sentence received, may not have parsed successfully
       std::string PlainText; // A human-readable string of text that explains what just happened
@@ -265,10 +285,61 @@ class NMEA0183
       std::string TalkerID;
       std::string ExpandedTalkerID;
 
-      virtual bool IsGood( void ) const noexcept;
-      virtual bool Parse( void ) noexcept;
-      virtual void SetSentence(std::string_view source) noexcept;
-      virtual void GetSentence(std::string& destination) const noexcept;
+      /*
+      ** PlainText, TalkerID and ExpandedTalkerID are left alone when
+      ** FillTextOnParse is false. Use GetPlainText(), GetTalkerID() and
+      ** GetExpandedTalkerID() when you need them.
+      */
+
+      DUPLICATE_FILTER * Duplicates{ nullptr }; // Skips decoding exact repeats when set, see DUPLICAT.HPP
+      bool IsUnchanged{ false }; // The last Parse() found a repeat and left the sentence object alone
+
+      /*
+      ** Subscribe<RMC>( handler ) has Parse() call handler( RMC const& ) with
+      ** Rmc every time an RMC parses, Subscribe<RMC>( handler, { "GP", "GN" } )
+      ** only when it came from one of those talkers. Once anything is
+      ** subscribed, sentences nobody subscribed to are turned away with
+      ** NotSubscribed before their checksum is checked. Set FillTextOnParse
+      ** to false as well if nobody reads PlainText. Returns false when T
+      ** isn't one of the sentences this class knows or none of the talkers
+      ** is two letters long.
+      */
+
+      template <typename T, typename HANDLER>
+      bool Subscribe( HANDLER handler, std::initializer_list<std::string_view> talkers = {} )
+      {
+         static_assert( std::is_base_of_v<RESPONSE, T>, "Only sentences can be subscribed to" );
+
+         // A T knows its own mnemonic, the first response with that key is the one Parse() dispatches to
+
+         T const sentence;
+
+         for ( auto const response : m_ResponseTable )
+         {
+            if ( response->Key == sentence.Key )
+            {
+               return( m_Subscriptions.Add( response->Key, talkers, [ handler ]( RESPONSE const& source ) mutable { handler( static_cast<T const&>( source ) ); } ) );
+            }
+         }
+
+         return( false );
+      }
+
+      inline void Unsubscribe( void ) noexcept
+      {
+         m_Subscriptions.Clear();
+      }
+
+      virtual std::string GetExpandedTalkerID( void ) const noexcept;
+      inline RESPONSE const * GetLastResponse( void ) const noexcept { return( m_LastResponse ); } // The one that parsed the last good sentence
+      virtual std::string GetPlainText( void ) const noexcept;
+      virtual std::string_view GetTalkerID( void ) const noexcept;
+      inline TAG_BLOCK const& GetTagBlock( void ) const noexcept { return( m_Sentence.TagBlock ); }
+      bool IsGood( void ) const noexcept;
+      virtual bool Parse( void ) noexcept; // Override this one to see every sentence, the rest of the hot path isn't virtual
+      inline void SetSentence(std::string_view source) noexcept { m_Sentence = source; }
+      inline void BorrowSentence(std::string_view source) noexcept { m_Sentence.Borrow(source); } // Parse it where it is, see SENTENCE::Borrow()
+      inline void GetSentence(std::string& destination) const noexcept { destination = m_Sentence; }
 
       inline NMEA0183& operator << (std::string_view source) noexcept
       {
@@ -283,4 +354,14 @@ class NMEA0183
       }
 };
 
+#include "PARSER.HPP"
+#include "MAPFILE.HPP"
+#include "LOGFILE.HPP"
+#include "RECORDS.HPP"
+#include "RING.HPP"
+#include "INGEST.HPP"
+#include "SEQLOCK.HPP"
+#include "VESSEL.HPP"
+#include "EPOCH.HPP"
+
 #endif // NMEA_0183_CLASS_HEADER